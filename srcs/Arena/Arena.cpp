@@ -0,0 +1,52 @@
+#include "Arena.hpp"
+
+Arena::Arena()
+    : buffer_(),
+      counts_(),
+      upstream_(&this->counts_.upstream_allocations),
+      resource_(this->buffer_.data(), this->buffer_.size(), &this->upstream_) {}
+
+Arena::~Arena() {}
+
+// bufferの先頭に戻し、heapから確保した分を解放する
+void Arena::release() noexcept(true) {
+    this->resource_.release();
+    ++this->counts_.releases;
+}
+
+const s_arena_counts &Arena::counts() const noexcept(true) {
+    return this->counts_;
+}
+
+void *Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++this->counts_.allocations;
+    this->counts_.bytes += bytes;
+    return this->resource_.allocate(bytes, alignment);
+}
+
+void Arena::do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) {
+    this->resource_.deallocate(ptr, bytes, alignment);
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Arena::Upstream::Upstream(std::uint64_t *allocations) : allocations_(allocations) {}
+
+void *Arena::Upstream::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++*this->allocations_;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void Arena::Upstream::do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+}
+
+bool Arena::Upstream::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
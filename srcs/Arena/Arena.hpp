@@ -0,0 +1,62 @@
+#pragma once
+
+# include <array>
+# include <cstddef>
+# include <cstdint>
+# include <memory_resource>
+# include "computor.hpp"
+
+// Arenaの累計 (release()でも0に戻さない)
+//   allocations         : arenaへの確保要求の数
+//   bytes               : 確保要求のbyte数の和
+//   upstream_allocations: bufferに収まらずheapから確保した数
+//   releases            : release()の数 (= 解いた方程式の数)
+struct s_arena_counts {
+    std::uint64_t allocations;
+    std::uint64_t bytes;
+    std::uint64_t upstream_allocations;
+    std::uint64_t releases;
+};
+
+// 1つの方程式の間だけ使う一時的なdataのarena (std::pmr::monotonic_buffer_resource)
+// 先頭kBufferBytesは自身のbufferから、超えた分はheapから確保する. deallocateは何もしない
+// release()で全てを1度に解放し、次の方程式は再びbufferの先頭から使う
+// release()の前に、arenaから確保したcontainerは破棄するかclear()すること
+// (方程式をまたいでcapacityを保持するcontainerにはarenaを使わない)
+class Arena : public std::pmr::memory_resource {
+ public:
+    static constexpr std::size_t kBufferBytes = Computor::ARENA_BUFFER_BYTES;
+
+    Arena();
+    ~Arena() override;
+
+    void release() noexcept(true);
+    const s_arena_counts &counts() const noexcept(true);
+
+ private:
+    // heapからの確保を数える
+    class Upstream : public std::pmr::memory_resource {
+     public:
+        explicit Upstream(std::uint64_t *allocations);
+
+     private:
+        std::uint64_t *allocations_;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    alignas(std::max_align_t) std::array<std::byte, kBufferBytes> buffer_;
+    s_arena_counts counts_;
+    Upstream upstream_;
+    std::pmr::monotonic_buffer_resource resource_;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    // copy invalid
+    Arena &operator=(const Arena &rhs);
+    Arena(const Arena &other);
+};
@@ -1,60 +1,131 @@
 #include "Calculator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <numbers>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include "computor.hpp"
+#include "Trace.hpp"
 
-bool DEBUG = false;
+Calculator::Calculator() : Calculator(std::pmr::get_default_resource()) {}
 
-Calculator::Calculator(const std::map<std::int32_t, double> &polynomial)
-    : polynomial_(polynomial) {}
+Calculator::Calculator(std::pmr::memory_resource *resource)
+    : memory_resource_(resource),
+      polynomial_(nullptr),
+      kMinDegree_(0),
+      kMaxDegree_(2),
+      solution_type_(QuadraticSolver::NoSolutionCalculationError),
+      solutions_(),
+      root_finder_() {}
 
 Calculator::~Calculator() {}
 
-int Calculator::solve_quadratic_equation() noexcept(true) {
+int Calculator::solve_quadratic_equation(
+        const Polynomials &polynomial,
+        std::ostream &out) noexcept(true) {
+    OutputBuffer buffer;
+    int result = Calculator::solve_quadratic_equation(polynomial, &buffer);
+    buffer.write_to(out);
+    return result;
+}
+
+int Calculator::solve_quadratic_equation(
+        const Polynomials &polynomial,
+        OutputBuffer *out) noexcept(true) {
+    Calculator::solve_equation(polynomial);
+    return Calculator::format_result(this->solution_type_, this->solutions_, out);
+}
+
+// 解くだけで表示しない. 結果は次に解くまでsolution_type(), solutions()で取得する
+// polynomialは保持しない
+QuadraticSolver::SolutionType Calculator::solve_equation(
+        const Polynomials &polynomial) noexcept(true) {
+    Calculator::reset();
     this->kMinDegree_ = 0;
     this->kMaxDegree_ = 2;
 
-    // D
-    QuadraticSolver::SolutionType solution_type = Calculator::solve();
-    Calculator::display_solution_type(solution_type);
+    this->polynomial_ = &polynomial;
+    this->solution_type_ = Calculator::solve();
+    this->polynomial_ = nullptr;
+    return this->solution_type_;
+}
+
+void Calculator::set_root_finder_config(const s_root_finder_config &config) noexcept(true) {
+    this->root_finder_.set_config(config);
+}
+
+void Calculator::reset() noexcept(true) {
+    this->solution_type_ = QuadraticSolver::NoSolutionCalculationError;
+    this->solutions_.clear();
+}
+
+QuadraticSolver::SolutionType Calculator::solution_type() const noexcept(true) {
+    return this->solution_type_;
+}
+
+const std::vector<QuadraticSolver::Solution> &Calculator::solutions() const noexcept(true) {
+    return this->solutions_;
+}
 
-    // solve
-    std::vector<QuadraticSolver::Solution> solutions = this->solutions_;
-    Calculator::display_solutions(solutions, solution_type);
-    return Calculator::solve_result();
+// solve_quadratic_equation()の結果 (cacheした結果) をoutに追加する
+// 戻り値は解が1つ以上あればEXIT_SUCCESS
+int Calculator::format_result(
+        QuadraticSolver::SolutionType type,
+        const std::vector<QuadraticSolver::Solution> &solutions,
+        OutputBuffer *out) noexcept(true) {
+    Calculator::format_solution_type(type, out);
+    Calculator::format_solutions(solutions, type, out);
+    return solutions.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 // aX^2 + bX^1 + cX^0 = 0
 //  a == 0 -> 一次
+// degree == 3, 4 -> 解の公式 (Cardano, Ferrari)
+// 5 <= degree <= POLYNOMIAL_MAX_DEGREE -> solve_polynomial()
 QuadraticSolver::SolutionType Calculator::solve() noexcept(true) {
-    std::int32_t polynomial_min_degree = this->polynomial_.begin()->first;
-    std::int32_t polynomial_max_degree = this->polynomial_.rbegin()->first;
+    std::int32_t polynomial_min_degree = this->polynomial_->begin()->first;
+    std::int32_t polynomial_max_degree = this->polynomial_->rbegin()->first;
 
     if (polynomial_min_degree < this->kMinDegree_) {
         return QuadraticSolver::NoSolutionDegreeTooLow;
     }
-    if (this->kMaxDegree_ < polynomial_max_degree) {
+    if (Computor::POLYNOMIAL_MAX_DEGREE < polynomial_max_degree) {
         return QuadraticSolver::NoSolutionDegreeTooHigh;
     }
+    if (polynomial_max_degree == 3) {
+        return Calculator::solve_cubic_equation();
+    }
+    if (polynomial_max_degree == 4) {
+        return Calculator::solve_quartic_equation();
+    }
+    if (this->kMaxDegree_ < polynomial_max_degree) {
+        return Calculator::solve_polynomial();
+    }
 
-    double a, b, c;
-    a = (this->polynomial_.find(2) != this->polynomial_.end()) ? this->polynomial_.at(2) : 0.0;
-    b = (this->polynomial_.find(1) != this->polynomial_.end()) ? this->polynomial_.at(1) : 0.0;
-    c = (this->polynomial_.find(0) != this->polynomial_.end()) ? this->polynomial_.at(0) : 0.0;
+    double a = Calculator::coefficient(2);
+    double b = Calculator::coefficient(1);
+    double c = Calculator::coefficient(0);
 
     QuadraticSolver::EquationType eq_type = Calculator::get_equation_type(a, b);
     QuadraticSolver::SolutionType solution_type;
-    std::vector<QuadraticSolver::Solution> solutions;
     switch (eq_type) {
         case QuadraticSolver::Quadratic: {
             double D = b * b - 4 * a * c;
             solution_type = Calculator::get_quadratic_eq_solution_type(D);
-            this->solutions_ = Calculator::solve_quadratic(a, b, D, solution_type);
+            Calculator::solve_quadratic(a, b, D, solution_type, &this->solutions_);
             break;
         }
         case QuadraticSolver::Linear:
             solution_type = QuadraticSolver::OneRealSolutionLinear;
-            this->solutions_ = Calculator::solve_linear(b, c, solution_type);
+            Calculator::solve_linear(b, c, solution_type, &this->solutions_);
             break;
         case QuadraticSolver::Constant:
             solution_type = Calculator::get_constant_eq_solution_type(c);
@@ -63,76 +134,613 @@ QuadraticSolver::SolutionType Calculator::solve() noexcept(true) {
     return solution_type;
 }
 
-std::vector<QuadraticSolver::Solution> Calculator::solve_quadratic(
-        double a,
-        double b,
-        double D,
-        QuadraticSolver::SolutionType type) noexcept(true) {
-    std::vector<QuadraticSolver::Solution> solutions;
+// RootFinderで全ての複素数解を求め、refine_roots()で達成した精度の範囲で整える
+// 重解はrefine_roots()で同じ値になり、sort_solutions()で1度だけ残す
+QuadraticSolver::SolutionType Calculator::solve_polynomial() noexcept(true) {
+    std::int32_t degree = this->polynomial_->rbegin()->first;
 
+    this->solutions_.clear();
     try {
-        double d = Computor::abs(D);
-
-        switch (type) {
-            case QuadraticSolver::TwoComplexSolutionsQuadratic: {
-                if (DEBUG) std::cout << "solve_quadratic() 2-complex" << std::endl;
-                QuadraticSolver::Solution ans1, ans2;
-                ans1 = {
-                        .re = Computor::normalize_zero(-b / 2.0 / a),
-                        .im = Computor::normalize_zero(Computor::sqrt(d) / 2.0 / a)
-                };
-                ans2 = {
-                        .re = Computor::normalize_zero(-b / 2.0 / a),
-                        .im = Computor::normalize_zero(-Computor::sqrt(d) / 2.0 / a)
-                };
-                solutions.push_back(ans1);
-                solutions.push_back(ans2);
-                break;
+        std::pmr::vector<double> coefficients(
+                static_cast<std::size_t>(degree) + 1, 0.0, this->memory_resource_);
+        for (const auto &term : *this->polynomial_) {
+            coefficients[static_cast<std::size_t>(term.first)] = term.second;
+        }
+
+        if (this->root_finder_.solve(coefficients) == Computor::FAILURE) {
+            return QuadraticSolver::NoSolutionCalculationError;
+        }
+
+        Calculator::refine_roots(this->root_finder_.roots(), this->root_finder_.radii(),
+                                 this->memory_resource_, &this->solutions_);
+    } catch (const std::exception &e) {
+        this->solutions_.clear();
+        return QuadraticSolver::NoSolutionCalculationError;
+    }
+
+    Calculator::sort_solutions(&this->solutions_);
+    return QuadraticSolver::SolutionsPolynomial;
+}
+
+// 実係数の多項式の解 roots (包含円の半径 radii) を、達成した精度の範囲で整えてsolutionsに追加する
+//   1. 包含円が重なる解をまとめ、平均で置き換える (m重解の近似の平均は1つの近似より正確)
+//   2. 包含円が実軸 (虚軸) と交わる解の虚部 (実部) は0とする
+//   3. 虚部が正の解を、包含円が共役と重なる最も近い虚部が負の解と組にし、組の平均で置き換える
+// O(n^2)で、RootFinderの1回のsweepと同程度. 途中の値はresourceから確保する
+void Calculator::refine_roots(
+        const std::vector<std::complex<double>> &roots,
+        const std::vector<double> &radii,
+        std::pmr::memory_resource *resource,
+        std::vector<QuadraticSolver::Solution> *solutions) noexcept(false) {
+    const std::size_t size = roots.size();
+    std::pmr::vector<std::complex<double>> refined(roots.begin(), roots.end(), resource);
+    std::pmr::vector<double> refined_radii(radii.begin(), radii.end(), resource);
+
+    // 1. union-findでまとめる. cluster[i]は解iの属するまとまりの代表
+    std::pmr::vector<std::size_t> cluster(size, 0, resource);
+    for (std::size_t i = 0; i < size; ++i) {
+        cluster[i] = i;
+    }
+    auto find = [&cluster](std::size_t i) {
+        while (cluster[i] != i) {
+            cluster[i] = cluster[cluster[i]];
+            i = cluster[i];
+        }
+        return i;
+    };
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = i + 1; j < size; ++j) {
+            if (Calculator::is_within(roots[i] - roots[j], radii[i] + radii[j])) {
+                cluster[find(j)] = find(i);
             }
-            case QuadraticSolver::TwoRealSolutionsQuadratic: {
-                if (DEBUG) std::cout << "solve_quadratic() 2-real" << std::endl;
-                QuadraticSolver::Solution ans1, ans2;
-                ans1.re = Computor::normalize_zero((-b + Computor::sqrt(d)) / 2.0 / a);
-                ans2.re = Computor::normalize_zero((-b - Computor::sqrt(d)) / 2.0 / a);
-                solutions.push_back(ans1);
-                solutions.push_back(ans2);
-                break;
+        }
+    }
+    std::pmr::vector<std::complex<double>> sums(size, 0.0, resource);
+    std::pmr::vector<std::size_t> counts(size, 0, resource);
+    std::pmr::vector<double> cluster_radii(size, 0.0, resource);
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t root = find(i);
+        sums[root] += roots[i];
+        ++counts[root];
+        cluster_radii[root] = std::max(cluster_radii[root], radii[i]);
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t root = find(i);
+        refined[i] = sums[root] / static_cast<double>(counts[root]);
+        refined_radii[i] = cluster_radii[root];
+    }
+
+    // 2. 丸め
+    for (std::size_t i = 0; i < size; ++i) {
+        if (Computor::abs(refined[i].imag()) <= refined_radii[i]) {
+            refined[i].imag(0.0);
+        }
+        if (Computor::abs(refined[i].real()) <= refined_radii[i]) {
+            refined[i].real(0.0);
+        }
+    }
+
+    // 3. 共役の組
+    std::pmr::vector<std::uint8_t> is_paired(size, 0, resource);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (refined[i].imag() <= 0.0) {
+            continue;
+        }
+        std::size_t partner = size;
+        double partner_distance = std::numeric_limits<double>::infinity();
+        for (std::size_t j = 0; j < size; ++j) {
+            if (is_paired[j] || 0.0 <= refined[j].imag()) {
+                continue;
             }
-            case QuadraticSolver::OneRealSolutionQuadratic: {
-                if (DEBUG) std::cout << "solve_quadratic() 1-real" << std::endl;
-                QuadraticSolver::Solution ans;
-                ans.re = Computor::normalize_zero(-b / 2.0 / a);
-                solutions.push_back(ans);
-                break;
+            std::complex<double> difference = refined[i] - std::conj(refined[j]);
+            if (!Calculator::is_within(difference, refined_radii[i] + refined_radii[j])) {
+                continue;
+            }
+            double distance = std::abs(difference);
+            if (distance < partner_distance) {
+                partner = j;
+                partner_distance = distance;
             }
-            default:
-                break;
         }
-        return solutions;
-    } catch (const std::exception &e) {
-        // sqrt(negative)
-        return solutions;
+        if (partner == size) {
+            continue;
+        }
+        std::complex<double> mean = (refined[i] + std::conj(refined[partner])) / 2.0;
+        refined[i] = mean;
+        refined[partner] = std::conj(mean);
+        is_paired[partner] = 1;
+    }
+
+    for (const std::complex<double> &root : refined) {
+        solutions->push_back(Calculator::to_solution(root, 0.0));
+    }
+}
+
+// |difference| <= reach
+// |difference|^2 はunder/overflowし得るため (|difference| < 1e-154 など)、
+// 成分で範囲外と分かる組を除いてからstd::abs()で比べる
+bool Calculator::is_within(std::complex<double> difference, double reach) noexcept(true) {
+    if (reach < Computor::abs(difference.real()) || reach < Computor::abs(difference.imag())) {
+        return false;
+    }
+    return std::abs(difference) <= reach;
+}
+
+double Calculator::coefficient(std::int32_t degree) const noexcept(true) {
+    auto itr = this->polynomial_->find(degree);
+    return itr != this->polynomial_->end() ? itr->second : 0.0;
+}
+
+// aX^3 + bX^2 + cX + d = 0 (a != 0)
+// 解けない場合、係数の大きさが極端に異なり解の精度が足りない場合はsolve_polynomial()で解く
+QuadraticSolver::SolutionType Calculator::solve_cubic_equation() noexcept(true) {
+    const std::array<double, 4> coefficients = {
+            Calculator::coefficient(0),
+            Calculator::coefficient(1),
+            Calculator::coefficient(2),
+            Calculator::coefficient(3)
+    };
+    QuadraticSolver::s_depressed_cubic cubic = Calculator::depress_cubic(
+            coefficients[3], coefficients[2], coefficients[1], coefficients[0]);
+
+    QuadraticSolver::SolutionType solution_type = Calculator::get_cubic_eq_solution_type(cubic);
+    Calculator::solve_cubic(
+            coefficients, cubic, solution_type, this->memory_resource_, &this->solutions_);
+    if (this->solutions_.empty() || !Calculator::is_accurate(coefficients, this->solutions_)) {
+        return Calculator::solve_polynomial();
+    }
+    return solution_type;
+}
+
+// aX^4 + bX^3 + cX^2 + dX + e = 0 (a != 0)
+// 途中の値がnan, infになった場合、解の精度が足りない場合はsolve_polynomial()で解く
+QuadraticSolver::SolutionType Calculator::solve_quartic_equation() noexcept(true) {
+    const std::array<double, 5> coefficients = {
+            Calculator::coefficient(0),
+            Calculator::coefficient(1),
+            Calculator::coefficient(2),
+            Calculator::coefficient(3),
+            Calculator::coefficient(4)
+    };
+
+    Calculator::solve_quartic(coefficients, this->memory_resource_, &this->solutions_);
+    if (this->solutions_.empty() || !Calculator::is_accurate(coefficients, this->solutions_)) {
+        return Calculator::solve_polynomial();
     }
+    return Calculator::get_quartic_eq_solution_type(this->solutions_);
 }
 
-std::vector<QuadraticSolver::Solution> Calculator::solve_linear(
+// 解をsolutionsに追加する (solutionsのcapacityを再利用する)
+void Calculator::solve_quadratic(
+        double a,
         double b,
-        double c,
-        QuadraticSolver::SolutionType type) noexcept(true) {
-    std::vector<QuadraticSolver::Solution> solutions;
+        double D,
+        QuadraticSolver::SolutionType type,
+        std::vector<QuadraticSolver::Solution> *solutions) noexcept(true) {
+    // |D|はnan, infでない (get_quadratic_eq_solution_type()で除外済み)
+    std::pair<Computor::Status, double> root = Computor::try_sqrt(Computor::abs(D));
+    if (root.first == Computor::FAILURE) {
+        return;
+    }
+    double sqrt_d = root.second;
+
+    switch (type) {
+        case QuadraticSolver::TwoComplexSolutionsQuadratic: {
+            COMPUTOR_TRACE_POINT("solve_quadratic() 2-complex");
+            QuadraticSolver::Solution ans1 = {}, ans2 = {};
+            ans1 = {
+                    .re = Computor::normalize_zero(-b / 2.0 / a),
+                    .im = Computor::normalize_zero(sqrt_d / 2.0 / a)
+            };
+            ans2 = {
+                    .re = Computor::normalize_zero(-b / 2.0 / a),
+                    .im = Computor::normalize_zero(-sqrt_d / 2.0 / a)
+            };
+            solutions->push_back(ans1);
+            solutions->push_back(ans2);
+            break;
+        }
+        case QuadraticSolver::TwoRealSolutionsQuadratic: {
+            COMPUTOR_TRACE_POINT("solve_quadratic() 2-real");
+            QuadraticSolver::Solution ans1 = {}, ans2 = {};
+            ans1.re = Computor::normalize_zero((-b + sqrt_d) / 2.0 / a);
+            ans2.re = Computor::normalize_zero((-b - sqrt_d) / 2.0 / a);
+            solutions->push_back(ans1);
+            solutions->push_back(ans2);
+            break;
+        }
+        case QuadraticSolver::OneRealSolutionQuadratic: {
+            COMPUTOR_TRACE_POINT("solve_quadratic() 1-real");
+            QuadraticSolver::Solution ans = {};
+            ans.re = Computor::normalize_zero(-b / 2.0 / a);
+            solutions->push_back(ans);
+            break;
+        }
+        default:
+            break;
+    }
+}
 
+void Calculator::solve_linear(
+        double b,
+        double c,
+        QuadraticSolver::SolutionType type,
+        std::vector<QuadraticSolver::Solution> *solutions) noexcept(true) {
     switch (type) {
         case QuadraticSolver::OneRealSolutionLinear: {
-            if (DEBUG) std::cout << "solve_linear() 1-real" << std::endl;
-            QuadraticSolver::Solution ans;
+            COMPUTOR_TRACE_POINT("solve_linear() 1-real");
+            QuadraticSolver::Solution ans = {};
             ans.re = Computor::normalize_zero(-c / b);
-            solutions.push_back(ans);
+            solutions->push_back(ans);
             break;
         }
         default:
             break;
     }
-    return solutions;
+}
+
+// X = t - b / 3a で2次の項を消す
+//   p = c/a - (b/a)^2 / 3
+//   q = 2 (b/a)^3 / 27 - (b/a)(c/a) / 3 + d/a
+QuadraticSolver::s_depressed_cubic Calculator::depress_cubic(
+        double a,
+        double b,
+        double c,
+        double d) noexcept(true) {
+    double B = b / a;
+    double C = c / a;
+    double D = d / a;
+
+    QuadraticSolver::s_depressed_cubic cubic;
+    cubic.shift = B / 3.0;
+    cubic.p = C - B * B / 3.0;
+    cubic.q = 2.0 * B * B * B / 27.0 - B * C / 3.0 + D;
+    cubic.p_scale = Computor::abs(C) + B * B / 3.0;
+    cubic.q_scale = Computor::abs(2.0 * B * B * B / 27.0)
+                    + Computor::abs(B * C / 3.0)
+                    + Computor::abs(D);
+    return cubic;
+}
+
+// Cardanoの判別式 (q/2)^2 + (p/3)^3 の符号で分類する
+// 判別式がp, qの丸め誤差の範囲で0の場合は重解とする
+QuadraticSolver::SolutionType Calculator::get_cubic_eq_solution_type(
+        const QuadraticSolver::s_depressed_cubic &cubic) noexcept(true) {
+    double discriminant = (cubic.q / 2.0) * (cubic.q / 2.0)
+                          + (cubic.p / 3.0) * (cubic.p / 3.0) * (cubic.p / 3.0);
+    double p_scale = cubic.p_scale / 3.0;
+    double q_scale = cubic.q_scale / 2.0;
+    double scale = q_scale * q_scale + p_scale * p_scale * p_scale;
+
+    if (Computor::isnan(discriminant) || Computor::isinf(discriminant)
+        || Computor::isinf(scale) || Computor::isinf(cubic.shift)) {
+        return QuadraticSolver::NoSolutionCalculationError;
+    }
+    if (Calculator::is_degenerate(discriminant, scale)) {
+        return QuadraticSolver::MultipleRealSolutionsCubic;
+    }
+    if (discriminant < 0.0) { return QuadraticSolver::ThreeRealSolutionsCubic; }
+    return QuadraticSolver::OneRealTwoComplexSolutionsCubic;
+}
+
+// 実数解の数で分類する (重解は1度だけ含まれる)
+QuadraticSolver::SolutionType Calculator::get_quartic_eq_solution_type(
+        const std::vector<QuadraticSolver::Solution> &solutions) noexcept(true) {
+    std::size_t real_count = 0;
+    for (const QuadraticSolver::Solution &solution : solutions) {
+        if (solution.im == 0.0) { ++real_count; }
+    }
+    if (real_count == solutions.size()) { return QuadraticSolver::FourRealSolutionsQuartic; }
+    if (real_count == 0) { return QuadraticSolver::FourComplexSolutionsQuartic; }
+    return QuadraticSolver::TwoRealTwoComplexSolutionsQuartic;
+}
+
+// t^3 + pt + q = 0 を解き、X = t - shift をNewton法で補正する
+//   3つの実数解  : 三角関数による解 (Vieta)
+//   1つの実数解  : Cardanoの公式. 桁落ちしない側の立方根を先に求める
+//   重解         : p ≒ 0 なら3重解 t = 0, それ以外は t = 3q/p, -3q/2p (2重解)
+// 解はsolutionsを置き換える. 途中の根はresourceから確保する
+template <typename Solutions>
+void Calculator::solve_cubic(
+        const std::array<double, 4> &coefficients,
+        const QuadraticSolver::s_depressed_cubic &cubic,
+        QuadraticSolver::SolutionType type,
+        std::pmr::memory_resource *resource,
+        Solutions *solutions) noexcept(true) {
+    const double p = cubic.p;
+    const double q = cubic.q;
+    std::pmr::vector<std::complex<double>> roots(resource);
+    roots.reserve(3);
+
+    switch (type) {
+        case QuadraticSolver::ThreeRealSolutionsCubic: {
+            COMPUTOR_TRACE_POINT("solve_cubic() 3-real");
+            double radius = 2.0 * std::sqrt(-p / 3.0);
+            double cos_arg = std::clamp(3.0 * q / (2.0 * p) * std::sqrt(-3.0 / p), -1.0, 1.0);
+            double angle = std::acos(cos_arg) / 3.0;
+            for (int k = 0; k < 3; ++k) {
+                double t = radius * std::cos(angle - 2.0 * std::numbers::pi * k / 3.0);
+                roots.emplace_back(t - cubic.shift, 0.0);
+            }
+            break;
+        }
+        case QuadraticSolver::OneRealTwoComplexSolutionsCubic: {
+            COMPUTOR_TRACE_POINT("solve_cubic() 1-real 2-complex");
+            double discriminant = (q / 2.0) * (q / 2.0) + (p / 3.0) * (p / 3.0) * (p / 3.0);
+            double u = std::cbrt(Computor::abs(q) / 2.0 + std::sqrt(discriminant));
+            if (0.0 < q) { u = -u; }
+            double v = (u == 0.0) ? 0.0 : -p / (3.0 * u);
+            roots.emplace_back(u + v - cubic.shift, 0.0);
+            roots.emplace_back(-(u + v) / 2.0 - cubic.shift,
+                               std::sqrt(3.0) / 2.0 * Computor::abs(u - v));
+            break;
+        }
+        case QuadraticSolver::MultipleRealSolutionsCubic: {
+            COMPUTOR_TRACE_POINT("solve_cubic() multiple-real");
+            if (Calculator::is_degenerate(p, cubic.p_scale)) {
+                roots.emplace_back(-cubic.shift, 0.0);
+                break;
+            }
+            roots.emplace_back(3.0 * q / p - cubic.shift, 0.0);
+            roots.emplace_back(-3.0 * q / (2.0 * p) - cubic.shift, 0.0);
+            break;
+        }
+        default:
+            break;
+    }
+
+    solutions->clear();
+    for (const std::complex<double> &root : roots) {
+        std::complex<double> polished = Calculator::round_root(
+                coefficients, Calculator::polish_root(coefficients, root));
+        solutions->push_back(Calculator::to_solution(polished, 0.0));
+        if (polished.imag() != 0.0) {
+            solutions->push_back(Calculator::to_solution(std::conj(polished), 0.0));
+        }
+    }
+    Calculator::sort_solutions(solutions);
+}
+
+// Ferrari法. X = y - b / 4a で y^4 + py^2 + qy + r = 0 とし、2つの実係数2次式に分解する
+//   (y^2 + sy + t1)(y^2 - sy + t2),  s = sqrt(2m),  t1, t2 = p/2 + m -+ q / 2s
+//   mは分解方程式 8m^3 + 8pm^2 + (2p^2 - 8r)m - q^2 = 0 の最大の実数解 (q != 0 なら m > 0)
+// q ≒ 0 の場合は複2次式 z^2 + pz + r = 0 (z = y^2) として解く
+// 解はsolutionsを置き換え、解けない (途中でnan, infになる) 場合は空にする
+// 途中の根はresourceから確保する
+void Calculator::solve_quartic(
+        const std::array<double, 5> &coefficients,
+        std::pmr::memory_resource *resource,
+        std::vector<QuadraticSolver::Solution> *solutions) noexcept(true) {
+    const double a = coefficients[4];
+    const double B = coefficients[3] / a;
+    const double C = coefficients[2] / a;
+    const double D = coefficients[1] / a;
+    const double E = coefficients[0] / a;
+
+    const double shift = B / 4.0;
+    const double p = C - 3.0 * B * B / 8.0;
+    const double q = B * B * B / 8.0 - B * C / 2.0 + D;
+    const double r = -3.0 * B * B * B * B / 256.0 + B * B * C / 16.0 - B * D / 4.0 + E;
+    const double p_scale = Computor::abs(C) + 3.0 * B * B / 8.0;
+    const double q_scale = Computor::abs(B * B * B / 8.0) + Computor::abs(B * C / 2.0)
+                           + Computor::abs(D);
+    const double r_scale = 3.0 * B * B * B * B / 256.0 + Computor::abs(B * B * C / 16.0)
+                           + Computor::abs(B * D / 4.0) + Computor::abs(E);
+
+    solutions->clear();
+    std::pmr::vector<std::complex<double>> roots(resource);
+    roots.reserve(4);
+    if (Calculator::is_degenerate(q, q_scale)) {
+        COMPUTOR_TRACE_POINT("solve_quartic() biquadratic");
+        std::pmr::vector<std::complex<double>> squares(resource);
+        squares.reserve(2);
+        Calculator::solve_quadratic_factor(p, r, p_scale * p_scale + 4.0 * r_scale, &squares);
+        for (const std::complex<double> &square : squares) {
+            std::complex<double> y = std::sqrt(square);
+            roots.push_back(y - shift);
+            roots.push_back(-y - shift);
+        }
+    } else {
+        COMPUTOR_TRACE_POINT("solve_quartic() ferrari");
+        QuadraticSolver::s_depressed_cubic resolvent = Calculator::depress_cubic(
+                8.0, 8.0 * p, 2.0 * p * p - 8.0 * r, -q * q);
+        QuadraticSolver::SolutionType resolvent_type =
+                Calculator::get_cubic_eq_solution_type(resolvent);
+        std::pmr::vector<QuadraticSolver::Solution> resolvent_roots(resource);
+        resolvent_roots.reserve(3);
+        Calculator::solve_cubic({-q * q, 2.0 * p * p - 8.0 * r, 8.0 * p, 8.0},
+                                resolvent, resolvent_type, resource, &resolvent_roots);
+        double m = 0.0;
+        for (const QuadraticSolver::Solution &solution : resolvent_roots) {
+            if (solution.im == 0.0) { m = std::max(m, solution.re); }
+        }
+        if (m <= 0.0) {
+            return;
+        }
+        double s = std::sqrt(2.0 * m);
+        double t1 = p / 2.0 + m - q / (2.0 * s);
+        double t2 = p / 2.0 + m + q / (2.0 * s);
+        double t_scale = p_scale / 2.0 + m + q_scale / (2.0 * s);
+
+        std::pmr::vector<std::complex<double>> factor_roots(resource);
+        factor_roots.reserve(4);
+        Calculator::solve_quadratic_factor(s, t1, s * s + 4.0 * t_scale, &factor_roots);
+        Calculator::solve_quadratic_factor(-s, t2, s * s + 4.0 * t_scale, &factor_roots);
+        for (const std::complex<double> &y : factor_roots) {
+            roots.push_back(y - shift);
+        }
+    }
+
+    for (const std::complex<double> &root : roots) {
+        std::complex<double> polished = Calculator::polish_root(coefficients, root);
+        if (!std::isfinite(polished.real()) || !std::isfinite(polished.imag())) {
+            solutions->clear();
+            return;
+        }
+        polished = Calculator::round_root(coefficients, polished);
+        solutions->push_back(Calculator::to_solution(polished, 0.0));
+    }
+    Calculator::sort_solutions(solutions);
+}
+
+// y^2 + by + c = 0 の解をrootsに追加する
+// 判別式が丸め誤差の範囲 (scale) で0の場合は重解として2つ追加する
+void Calculator::solve_quadratic_factor(
+        double b,
+        double c,
+        double scale,
+        std::pmr::vector<std::complex<double>> *roots) noexcept(true) {
+    double discriminant = b * b - 4.0 * c;
+    if (Calculator::is_degenerate(discriminant, scale)) {
+        roots->emplace_back(-b / 2.0, 0.0);
+        roots->emplace_back(-b / 2.0, 0.0);
+        return;
+    }
+    if (discriminant < 0.0) {
+        double im = std::sqrt(-discriminant) / 2.0;
+        roots->emplace_back(-b / 2.0, im);
+        roots->emplace_back(-b / 2.0, -im);
+        return;
+    }
+    // 桁落ちを避けるため、|b|と同じ符号の側を先に求める
+    double w = -(b + (b < 0.0 ? -1.0 : 1.0) * std::sqrt(discriminant)) / 2.0;
+    roots->emplace_back(w, 0.0);
+    roots->emplace_back(w == 0.0 ? 0.0 : c / w, 0.0);
+}
+
+// valueが、各項の絶対値の和がscaleとなる計算の丸め誤差程度以下
+bool Calculator::is_degenerate(double value, double scale) noexcept(true) {
+    const double kDegenerateTolerance = 1e3 * std::numeric_limits<double>::epsilon();
+    return Computor::abs(value) <= kDegenerateTolerance * scale;
+}
+
+// 元の方程式でNewton法を2回適用する. |f(x)|が小さくならない場合は補正しない
+// 実数解は実数のまま補正する
+template <std::size_t N>
+std::complex<double> Calculator::polish_root(
+        const std::array<double, N> &coefficients,
+        std::complex<double> root) noexcept(true) {
+    auto evaluate = [&coefficients](std::complex<double> x, std::complex<double> *derivative) {
+        std::complex<double> value = coefficients[N - 1];
+        *derivative = 0.0;
+        for (std::size_t i = N - 1; 0 < i; --i) {
+            *derivative = *derivative * x + value;
+            value = value * x + coefficients[i - 1];
+        }
+        return value;
+    };
+
+    const bool is_real = root.imag() == 0.0;
+    std::complex<double> derivative;
+    std::complex<double> value = evaluate(root, &derivative);
+    for (int i = 0; i < 2 && value != 0.0 && derivative != 0.0; ++i) {
+        std::complex<double> next = root - value / derivative;
+        if (is_real) {
+            next = next.real();
+        }
+        std::complex<double> next_derivative;
+        std::complex<double> next_value = evaluate(next, &next_derivative);
+        if (!(std::abs(next_value) < std::abs(value))) {
+            break;
+        }
+        root = next;
+        value = next_value;
+        derivative = next_derivative;
+    }
+    return root;
+}
+
+// 包含円 (RootFinder::inclusion_radius()と同じNewton法の包含円) に収まり、
+// 0としても |f(x)| が評価の丸め誤差程度以下となる実部 (虚部) は0とする
+//   X^3 + X^2 + X + 1 = 0 の -3.1225e-17+1i -> 0+1i
+// f'(x) = 0 の場合は半径が定まらないため、そのままとする
+template <std::size_t N>
+std::complex<double> Calculator::round_root(
+        const std::array<double, N> &coefficients,
+        std::complex<double> root) noexcept(true) {
+    const double kErrorBound = 4.0 * std::numeric_limits<double>::epsilon();
+    std::complex<double> value = coefficients[N - 1];
+    std::complex<double> derivative = 0.0;
+    double bound = Computor::abs(coefficients[N - 1]);
+    for (std::size_t i = N - 1; 0 < i; --i) {
+        derivative = derivative * root + value;
+        value = value * root + coefficients[i - 1];
+        bound = bound * std::abs(root) + Computor::abs(coefficients[i - 1]);
+    }
+    if (derivative == 0.0) {
+        return root;
+    }
+    const double radius = static_cast<double>(N - 1)
+                          * (std::abs(value) + kErrorBound * bound) / std::abs(derivative);
+
+    if (root.imag() != 0.0 && Computor::abs(root.imag()) <= radius
+        && Calculator::is_accurate(coefficients, std::complex<double>(root.real(), 0.0))) {
+        root.imag(0.0);
+    }
+    if (root.real() != 0.0 && Computor::abs(root.real()) <= radius
+        && Calculator::is_accurate(coefficients, std::complex<double>(0.0, root.imag()))) {
+        root.real(0.0);
+    }
+    return root;
+}
+
+// |f(x)| が評価の丸め誤差 (sum |c_i| |x|^i に比例) 程度以下
+template <std::size_t N>
+bool Calculator::is_accurate(
+        const std::array<double, N> &coefficients,
+        std::complex<double> x) noexcept(true) {
+    std::complex<double> value = coefficients[N - 1];
+    double bound = Computor::abs(coefficients[N - 1]);
+    for (std::size_t i = N - 1; 0 < i; --i) {
+        value = value * x + coefficients[i - 1];
+        bound = bound * std::abs(x) + Computor::abs(coefficients[i - 1]);
+    }
+    return std::isfinite(bound) && Calculator::is_degenerate(std::abs(value), bound);
+}
+
+// 全ての解xで is_accurate(coefficients, x)
+template <std::size_t N>
+bool Calculator::is_accurate(
+        const std::array<double, N> &coefficients,
+        const std::vector<QuadraticSolver::Solution> &solutions) noexcept(true) {
+    for (const QuadraticSolver::Solution &solution : solutions) {
+        std::complex<double> x(solution.re, solution.im);
+        if (!Calculator::is_accurate(coefficients, x)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 実部の降順、実部が等しい場合は虚部の降順に並べ、重解は1度だけ残す
+template <typename Solutions>
+void Calculator::sort_solutions(Solutions *solutions) noexcept(true) {
+    std::sort(solutions->begin(), solutions->end(),
+              [](const QuadraticSolver::Solution &lhs, const QuadraticSolver::Solution &rhs) {
+                  if (lhs.re != rhs.re) { return rhs.re < lhs.re; }
+                  return rhs.im < lhs.im;
+              });
+    auto last = std::unique(solutions->begin(), solutions->end(),
+                            [](const QuadraticSolver::Solution &lhs,
+                               const QuadraticSolver::Solution &rhs) {
+                                return lhs.re == rhs.re && lhs.im == rhs.im;
+                            });
+    solutions->erase(last, solutions->end());
+}
+
+// 絶対値がradius以下の実部, 虚部は0とする
+QuadraticSolver::Solution Calculator::to_solution(
+        std::complex<double> root,
+        double radius) noexcept(true) {
+    QuadraticSolver::Solution solution = {
+            .re = root.real(),
+            .im = root.imag()
+    };
+    if (Computor::abs(solution.re) <= radius) { solution.re = 0.0; }
+    if (Computor::abs(solution.im) <= radius) { solution.im = 0.0; }
+    solution.re = Computor::normalize_zero(solution.re);
+    solution.im = Computor::normalize_zero(solution.im);
+    return solution;
 }
 
 QuadraticSolver::EquationType Calculator::get_equation_type(double a, double b) noexcept(true) {
@@ -158,9 +766,11 @@ QuadraticSolver::SolutionType Calculator::get_constant_eq_solution_type(double c
     return c != 0.0 ? QuadraticSolver::NoSolution : QuadraticSolver::Indeterminate;
 }
 
-void Calculator::display_solution_type(QuadraticSolver::SolutionType type) noexcept(true) {
-    std::string solution;
-    if (DEBUG) std::cout << get_solution_type(type) << std::endl;
+void Calculator::format_solution_type(
+        QuadraticSolver::SolutionType type,
+        OutputBuffer *out) noexcept(true) {
+    std::string_view solution;
+    COMPUTOR_TRACE_VALUE("format_solution_type()", type);
 
     switch (type) {
         case QuadraticSolver::TwoRealSolutionsQuadratic:
@@ -172,6 +782,27 @@ void Calculator::display_solution_type(QuadraticSolver::SolutionType type) noexc
         case QuadraticSolver::OneRealSolutionQuadratic:
             solution = "Discriminant is zero, the solution is:";
             break;
+        case QuadraticSolver::ThreeRealSolutionsCubic:
+            solution = "Discriminant is positive, the three solutions are:";
+            break;
+        case QuadraticSolver::OneRealTwoComplexSolutionsCubic:
+            solution = "Discriminant is negative, the three solutions are:";
+            break;
+        case QuadraticSolver::MultipleRealSolutionsCubic:
+            solution = "Discriminant is zero, the solutions are:";
+            break;
+        case QuadraticSolver::FourRealSolutionsQuartic:
+            solution = "All solutions are real, the solutions are:";
+            break;
+        case QuadraticSolver::TwoRealTwoComplexSolutionsQuartic:
+            solution = "The solutions are real and complex:";
+            break;
+        case QuadraticSolver::FourComplexSolutionsQuartic:
+            solution = "All solutions are complex, the solutions are:";
+            break;
+        case QuadraticSolver::SolutionsPolynomial:
+            solution = "The polynomial degree is strictly greater than 2, the solutions are:";
+            break;
         case QuadraticSolver::OneRealSolutionLinear:
             solution = "The solution is:";
             break;
@@ -182,7 +813,9 @@ void Calculator::display_solution_type(QuadraticSolver::SolutionType type) noexc
             solution = "The polynomial degree is strictly less than 0, I can't solve.";
             break;
         case QuadraticSolver::NoSolutionDegreeTooHigh:
-            solution = "The polynomial degree is strictly greater than 2, I can't solve.";
+            out->append("The polynomial degree is strictly greater than ");
+            out->append(Computor::POLYNOMIAL_MAX_DEGREE);
+            solution = ", I can't solve.";
             break;
         case QuadraticSolver::NoSolutionCalculationError:
             solution = "Calculation error occurred, I can't solve.";
@@ -191,34 +824,37 @@ void Calculator::display_solution_type(QuadraticSolver::SolutionType type) noexc
             solution = "I can't solve.";
             break;
     }
-    std::cout << solution << std::endl;
+    out->append(solution);
+    out->append('\n');
 }
 
-void Calculator::display_solutions(
+void Calculator::format_solutions(
         const std::vector<QuadraticSolver::Solution> &solutions,
-        QuadraticSolver::SolutionType type) noexcept(true) {
+        QuadraticSolver::SolutionType type,
+        OutputBuffer *out) noexcept(true) {
     for (const auto &solution : solutions) {
         if (0 < solution.re) {
-            std::cout << " ";
+            out->append(' ');
         }
-        // std::cout << std::fixed << std::setprecision(2) << solution.re;
-        std::cout << solution.re;
-        if (type == QuadraticSolver::TwoComplexSolutionsQuadratic) {
+        out->append(solution.re);
+        if (type == QuadraticSolver::TwoComplexSolutionsQuadratic
+            || (Calculator::has_complex_solutions(type) && solution.im != 0.0)) {
             if (0 < solution.im) {
-                std::cout << "+";
+                out->append('+');
             }
-            // std::cout << std::fixed << std::setprecision(2) << solution.im << "i";
-            std::cout << solution.im << "i";
+            out->append(solution.im);
+            out->append('i');
         }
-        std::cout << std::endl;
+        out->append('\n');
     }
 }
 
-int Calculator::solve_result() noexcept(true) {
-    if (0 < this->solutions_.size()) {
-        return EXIT_SUCCESS;
-    }
-    return EXIT_FAILURE;
+// 実数解と虚数解が混在しうる (虚部が0の解は実数として表示する)
+bool Calculator::has_complex_solutions(QuadraticSolver::SolutionType type) noexcept(true) {
+    return type == QuadraticSolver::OneRealTwoComplexSolutionsCubic
+        || type == QuadraticSolver::TwoRealTwoComplexSolutionsQuartic
+        || type == QuadraticSolver::FourComplexSolutionsQuartic
+        || type == QuadraticSolver::SolutionsPolynomial;
 }
 
 std::string get_solution_type(QuadraticSolver::SolutionType type) noexcept(true) {
@@ -229,6 +865,20 @@ std::string get_solution_type(QuadraticSolver::SolutionType type) noexcept(true)
             return "Quadratic: 2-complex";
         case QuadraticSolver::OneRealSolutionQuadratic:
             return "Quadratic: 1-real";
+        case QuadraticSolver::ThreeRealSolutionsCubic:
+            return "Cubic: 3-real";
+        case QuadraticSolver::OneRealTwoComplexSolutionsCubic:
+            return "Cubic: 1-real 2-complex";
+        case QuadraticSolver::MultipleRealSolutionsCubic:
+            return "Cubic: multiple-real";
+        case QuadraticSolver::FourRealSolutionsQuartic:
+            return "Quartic: 4-real";
+        case QuadraticSolver::TwoRealTwoComplexSolutionsQuartic:
+            return "Quartic: 2-real 2-complex";
+        case QuadraticSolver::FourComplexSolutionsQuartic:
+            return "Quartic: 4-complex";
+        case QuadraticSolver::SolutionsPolynomial:
+            return "Polynomial: all-complex";
         case QuadraticSolver::OneRealSolutionLinear:
             return "Linear: 1-real";
         case QuadraticSolver::Indeterminate:
@@ -1,8 +1,15 @@
 #pragma once
 
-# include <map>
+# include <array>
+# include <complex>
+# include <cstddef>
+# include <iostream>
+# include <memory_resource>
 # include <string>
 # include <vector>
+# include "OutputBuffer.hpp"
+# include "Polynomial.hpp"
+# include "RootFinder.hpp"
 
 
 namespace QuadraticSolver {
@@ -13,12 +20,27 @@ enum EquationType {
     Constant,
 };
 
+// 重解は次数によらず1度だけ出力する (2次のOneRealSolutionQuadraticと同じ)
+// 3次以上では解の公式で解いた場合も、RootFinderで解いた場合 (SolutionsPolynomial) も同じ
 enum SolutionType {
     // 2次方程式
     TwoRealSolutionsQuadratic,      // 異なる2つの実数解
     TwoComplexSolutionsQuadratic,   // 異なる2つの虚数解
     OneRealSolutionQuadratic,       // ただ1つの実数解（重解）
 
+    // 3次方程式
+    ThreeRealSolutionsCubic,        // 異なる3つの実数解
+    OneRealTwoComplexSolutionsCubic,    // 1つの実数解と2つの虚数解
+    MultipleRealSolutionsCubic,     // 重解を含む実数解（2重解と実数解, 3重解）
+
+    // 4次方程式
+    FourRealSolutionsQuartic,       // 4つの実数解
+    TwoRealTwoComplexSolutionsQuartic,  // 2つの実数解と2つの虚数解
+    FourComplexSolutionsQuartic,    // 4つの虚数解
+
+    // 5次以上の方程式 (3, 4次で解の公式の精度が足りない場合を含む)
+    SolutionsPolynomial,            // 全ての複素数解
+
     // 1次方程式
     OneRealSolutionLinear,          // 1次方程式の実数解
 
@@ -39,46 +61,197 @@ struct Solution {
     double im;
 };
 
+// 3次方程式 aX^3 + bX^2 + cX + d = 0 を X = t - shift で変換した t^3 + pt + q = 0
+// p_scale, q_scale : p, qを求める際の各項の絶対値の和 (丸め誤差の大きさの目安)
+struct s_depressed_cubic {
+    double shift;
+    double p;
+    double q;
+    double p_scale;
+    double q_scale;
+};
+
+// batch用の命令セット
+enum BatchIsa {
+    Scalar,
+    Avx2,
+    Avx512,
+};
+
+// 整理済みの係数 (SoA): a[i] X^2 + b[i] X + c[i] = 0
+struct s_coefficient_arrays {
+    const double *a;
+    const double *b;
+    const double *c;
+};
+
+// batchの解 (SoA). 配列は呼び出し側が確保する
+//   2-real    : (re1, re2)
+//   2-complex : (re1 + im1 i, re2 + im2 i)
+//   1-real    : re1 (Quadratic, Linear)
+// 解のない要素は0.0
+struct s_solution_arrays {
+    SolutionType *types;
+    double *re1;
+    double *im1;
+    double *re2;
+    double *im2;
+};
+
 }  // namespace QuadraticSolver
 
 
+// 多項式は解く度に渡し、1つのCalculatorで複数の方程式を順に解く
+// solutions_, root_finder_の配列のcapacityは保持するため、
+// 2回目以降は次数が増えない限りheapを確保しない
+// 3次以上の方程式の途中の値 (根, 係数の配列) はresourceから確保する (arenaなら方程式毎にrelease())
 class Calculator {
  public:
-    explicit Calculator(const std::map<std::int32_t, double>&polynomial);
+    Calculator();
+    explicit Calculator(std::pmr::memory_resource *resource);
     ~Calculator();
 
-    void solve_equation() noexcept(true);
-    int solve_quadratic_equation() noexcept(true);
+    QuadraticSolver::SolutionType solve_equation(const Polynomials &polynomial) noexcept(true);
+    int solve_quadratic_equation(
+            const Polynomials &polynomial,
+            std::ostream &out = std::cout) noexcept(true);
+    int solve_quadratic_equation(
+            const Polynomials &polynomial,
+            OutputBuffer *out) noexcept(true);
+    void set_root_finder_config(const s_root_finder_config &config) noexcept(true);
+
+    // 解く前の状態に戻す. solutions_のcapacityは保持する
+    void reset() noexcept(true);
+
+    QuadraticSolver::SolutionType solution_type() const noexcept(true);
+    const std::vector<QuadraticSolver::Solution> &solutions() const noexcept(true);
+    static int format_result(
+            QuadraticSolver::SolutionType type,
+            const std::vector<QuadraticSolver::Solution> &solutions,
+            OutputBuffer *out) noexcept(true);
+
+    static void solve_quadratic_batch(
+            const QuadraticSolver::s_coefficient_arrays &coefficients,
+            const QuadraticSolver::s_solution_arrays &solutions,
+            std::size_t size,
+            QuadraticSolver::BatchIsa isa = Calculator::detect_batch_isa()) noexcept(true);
+    static QuadraticSolver::BatchIsa detect_batch_isa() noexcept(true);
 
  private:
-    const std::map<std::int32_t, double> polynomial_;
+    std::pmr::memory_resource *memory_resource_;    // 所有しない
+    const Polynomials *polynomial_;     // solve_equation()の間のみ有効. 所有しない
     std::int32_t kMinDegree_, kMaxDegree_;
 
+    QuadraticSolver::SolutionType solution_type_;
     std::vector<QuadraticSolver::Solution> solutions_;
+    RootFinder root_finder_;            // 5次以上用. thread pool, 配列を方程式間で再利用する
 
     QuadraticSolver::SolutionType solve() noexcept(true);
-    int solve_result() noexcept(true);
+    QuadraticSolver::SolutionType solve_cubic_equation() noexcept(true);
+    QuadraticSolver::SolutionType solve_quartic_equation() noexcept(true);
+    QuadraticSolver::SolutionType solve_polynomial() noexcept(true);
+    double coefficient(std::int32_t degree) const noexcept(true);
     static QuadraticSolver::EquationType get_equation_type(double a, double b) noexcept(true);
     static QuadraticSolver::SolutionType get_quadratic_eq_solution_type(double D) noexcept(true);
     static QuadraticSolver::SolutionType get_constant_eq_solution_type(double c) noexcept(true);
+    static QuadraticSolver::SolutionType get_cubic_eq_solution_type(
+            const QuadraticSolver::s_depressed_cubic &cubic) noexcept(true);
+    static QuadraticSolver::SolutionType get_quartic_eq_solution_type(
+            const std::vector<QuadraticSolver::Solution> &solutions) noexcept(true);
 
-    static void display_solution_type(QuadraticSolver::SolutionType type) noexcept(true);
+    static void format_solution_type(
+            QuadraticSolver::SolutionType type,
+            OutputBuffer *out) noexcept(true);
 
-    static std::vector<QuadraticSolver::Solution> solve_quadratic(
+    static void solve_quadratic(
             double a,
             double b,
             double D,
-            QuadraticSolver::SolutionType type) noexcept(true);
-    static std::vector<QuadraticSolver::Solution> solve_linear(
+            QuadraticSolver::SolutionType type,
+            std::vector<QuadraticSolver::Solution> *solutions) noexcept(true);
+    static void solve_linear(
             double b,
             double c,
-            QuadraticSolver::SolutionType type) noexcept(true);
-    static void display_solutions(
+            QuadraticSolver::SolutionType type,
+            std::vector<QuadraticSolver::Solution> *solutions) noexcept(true);
+    static QuadraticSolver::s_depressed_cubic depress_cubic(
+            double a,
+            double b,
+            double c,
+            double d) noexcept(true);
+    template <typename Solutions>
+    static void solve_cubic(
+            const std::array<double, 4> &coefficients,
+            const QuadraticSolver::s_depressed_cubic &cubic,
+            QuadraticSolver::SolutionType type,
+            std::pmr::memory_resource *resource,
+            Solutions *solutions) noexcept(true);
+    static void solve_quartic(
+            const std::array<double, 5> &coefficients,
+            std::pmr::memory_resource *resource,
+            std::vector<QuadraticSolver::Solution> *solutions) noexcept(true);
+    static void solve_quadratic_factor(
+            double b,
+            double c,
+            double scale,
+            std::pmr::vector<std::complex<double>> *roots) noexcept(true);
+    static bool is_degenerate(double value, double scale) noexcept(true);
+    template <std::size_t N>
+    static std::complex<double> polish_root(
+            const std::array<double, N> &coefficients,
+            std::complex<double> root) noexcept(true);
+    template <std::size_t N>
+    static std::complex<double> round_root(
+            const std::array<double, N> &coefficients,
+            std::complex<double> root) noexcept(true);
+    template <std::size_t N>
+    static bool is_accurate(
+            const std::array<double, N> &coefficients,
+            std::complex<double> x) noexcept(true);
+    template <std::size_t N>
+    static bool is_accurate(
+            const std::array<double, N> &coefficients,
+            const std::vector<QuadraticSolver::Solution> &solutions) noexcept(true);
+    template <typename Solutions>
+    static void sort_solutions(Solutions *solutions) noexcept(true);
+    static void refine_roots(
+            const std::vector<std::complex<double>> &roots,
+            const std::vector<double> &radii,
+            std::pmr::memory_resource *resource,
+            std::vector<QuadraticSolver::Solution> *solutions) noexcept(false);
+    static bool is_within(std::complex<double> difference, double reach) noexcept(true);
+    static QuadraticSolver::Solution to_solution(
+            std::complex<double> root,
+            double radius) noexcept(true);
+    static void format_solutions(
             const std::vector<QuadraticSolver::Solution> &solutions,
-            QuadraticSolver::SolutionType type) noexcept(true);
+            QuadraticSolver::SolutionType type,
+            OutputBuffer *out) noexcept(true);
+    static bool has_complex_solutions(QuadraticSolver::SolutionType type) noexcept(true);
 
-    // invalid
-    Calculator();
+    static void solve_quadratic_batch_scalar(
+            const QuadraticSolver::s_coefficient_arrays &coefficients,
+            const QuadraticSolver::s_solution_arrays &solutions,
+            std::size_t begin,
+            std::size_t end) noexcept(true);
+    static std::size_t solve_quadratic_batch_avx2(
+            const QuadraticSolver::s_coefficient_arrays &coefficients,
+            const QuadraticSolver::s_solution_arrays &solutions,
+            std::size_t size) noexcept(true);
+    static std::size_t solve_quadratic_batch_avx512(
+            const QuadraticSolver::s_coefficient_arrays &coefficients,
+            const QuadraticSolver::s_solution_arrays &solutions,
+            std::size_t size) noexcept(true);
+    static QuadraticSolver::SolutionType get_batch_solution_type(
+            unsigned lane,
+            unsigned is_quadratic,
+            unsigned is_error,
+            unsigned is_negative,
+            unsigned is_positive,
+            unsigned is_linear,
+            unsigned is_c_nonzero) noexcept(true);
+
+    // copy invalid
     Calculator(const Calculator &other);
     Calculator &operator=(const Calculator &rhs);
 };
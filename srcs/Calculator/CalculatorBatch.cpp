@@ -0,0 +1,275 @@
+#include <cmath>
+#include <cstdint>
+#include "Calculator.hpp"
+#include "computor.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+# define COMPUTOR_X86_SIMD 1
+# include <immintrin.h>
+#else
+# define COMPUTOR_X86_SIMD 0
+#endif
+
+// 整理済みの係数 (a, b, c) の配列をまとめて解く. 分類はsolve()と同じ:
+//   a != 0 : D = b^2 - 4ac を get_quadratic_eq_solution_type(D) で分類
+//   a == 0 : b != 0 ならLinear, それ以外は get_constant_eq_solution_type(c)
+// 全ての命令セットで演算の順序を揃え、結果はbit単位で一致させる
+// (sqrtは全ての経路で正しく丸められるhardware sqrtを使う)
+void Calculator::solve_quadratic_batch(
+        const QuadraticSolver::s_coefficient_arrays &coefficients,
+        const QuadraticSolver::s_solution_arrays &solutions,
+        std::size_t size,
+        QuadraticSolver::BatchIsa isa) noexcept(true) {
+    std::size_t done = 0;
+
+    switch (isa) {
+        case QuadraticSolver::Avx512:
+            done = Calculator::solve_quadratic_batch_avx512(coefficients, solutions, size);
+            break;
+        case QuadraticSolver::Avx2:
+            done = Calculator::solve_quadratic_batch_avx2(coefficients, solutions, size);
+            break;
+        case QuadraticSolver::Scalar:
+            break;
+    }
+    Calculator::solve_quadratic_batch_scalar(coefficients, solutions, done, size);
+}
+
+QuadraticSolver::BatchIsa Calculator::detect_batch_isa() noexcept(true) {
+#if COMPUTOR_X86_SIMD
+    if (__builtin_cpu_supports("avx512f")) { return QuadraticSolver::Avx512; }
+    if (__builtin_cpu_supports("avx2")) { return QuadraticSolver::Avx2; }
+#endif
+    return QuadraticSolver::Scalar;
+}
+
+void Calculator::solve_quadratic_batch_scalar(
+        const QuadraticSolver::s_coefficient_arrays &coefficients,
+        const QuadraticSolver::s_solution_arrays &solutions,
+        std::size_t begin,
+        std::size_t end) noexcept(true) {
+    for (std::size_t i = begin; i < end; ++i) {
+        double a = coefficients.a[i];
+        double b = coefficients.b[i];
+        double c = coefficients.c[i];
+        QuadraticSolver::SolutionType type = QuadraticSolver::NoSolution;
+        double re1 = 0.0, im1 = 0.0, re2 = 0.0, im2 = 0.0;
+
+        switch (Calculator::get_equation_type(a, b)) {
+            case QuadraticSolver::Quadratic: {
+                double D = b * b - 4 * a * c;
+                double s = std::sqrt(Computor::abs(D));
+                type = Calculator::get_quadratic_eq_solution_type(D);
+                if (type == QuadraticSolver::TwoRealSolutionsQuadratic) {
+                    re1 = Computor::normalize_zero((-b + s) / 2.0 / a);
+                    re2 = Computor::normalize_zero((-b - s) / 2.0 / a);
+                } else if (type == QuadraticSolver::TwoComplexSolutionsQuadratic) {
+                    re1 = Computor::normalize_zero(-b / 2.0 / a);
+                    im1 = Computor::normalize_zero(s / 2.0 / a);
+                    re2 = re1;
+                    im2 = Computor::normalize_zero(-s / 2.0 / a);
+                } else if (type == QuadraticSolver::OneRealSolutionQuadratic) {
+                    re1 = Computor::normalize_zero(-b / 2.0 / a);
+                }
+                break;
+            }
+            case QuadraticSolver::Linear:
+                type = QuadraticSolver::OneRealSolutionLinear;
+                re1 = Computor::normalize_zero(-c / b);
+                break;
+            case QuadraticSolver::Constant:
+                type = Calculator::get_constant_eq_solution_type(c);
+                break;
+        }
+        solutions.types[i] = type;
+        solutions.re1[i] = re1;
+        solutions.im1[i] = im1;
+        solutions.re2[i] = re2;
+        solutions.im2[i] = im2;
+    }
+}
+
+// SIMDで求めた比較結果のbit mask (bit i = lane i) から、laneの解の種類を求める
+QuadraticSolver::SolutionType Calculator::get_batch_solution_type(
+        unsigned lane,
+        unsigned is_quadratic,
+        unsigned is_error,
+        unsigned is_negative,
+        unsigned is_positive,
+        unsigned is_linear,
+        unsigned is_c_nonzero) noexcept(true) {
+    unsigned bit = 1u << lane;
+
+    if (is_quadratic & bit) {
+        if (is_error & bit) { return QuadraticSolver::NoSolutionCalculationError; }
+        if (is_negative & bit) { return QuadraticSolver::TwoComplexSolutionsQuadratic; }
+        if (is_positive & bit) { return QuadraticSolver::TwoRealSolutionsQuadratic; }
+        return QuadraticSolver::OneRealSolutionQuadratic;
+    }
+    if (is_linear & bit) { return QuadraticSolver::OneRealSolutionLinear; }
+    return (is_c_nonzero & bit) ? QuadraticSolver::NoSolution : QuadraticSolver::Indeterminate;
+}
+
+#if COMPUTOR_X86_SIMD
+
+// 4要素ずつ処理し、処理した要素数を返す (残りはscalarで処理する)
+__attribute__((target("avx2")))
+std::size_t Calculator::solve_quadratic_batch_avx2(
+        const QuadraticSolver::s_coefficient_arrays &coefficients,
+        const QuadraticSolver::s_solution_arrays &solutions,
+        std::size_t size) noexcept(true) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    std::size_t i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+        __m256d a = _mm256_loadu_pd(coefficients.a + i);
+        __m256d b = _mm256_loadu_pd(coefficients.b + i);
+        __m256d c = _mm256_loadu_pd(coefficients.c + i);
+
+        // D = b * b - 4 * a * c (scalarと同じ順序, FMAは使わない)
+        __m256d D = _mm256_sub_pd(_mm256_mul_pd(b, b), _mm256_mul_pd(_mm256_mul_pd(four, a), c));
+        __m256d s = _mm256_sqrt_pd(_mm256_andnot_pd(sign, D));
+        __m256d neg_b = _mm256_xor_pd(b, sign);
+        __m256d neg_s = _mm256_xor_pd(s, sign);
+        __m256d neg_c = _mm256_xor_pd(c, sign);
+
+        // D - D はDがnan, infの場合のみnan
+        __m256d D_sub = _mm256_sub_pd(D, D);
+        __m256d is_quadratic = _mm256_cmp_pd(a, zero, _CMP_NEQ_UQ);
+        __m256d is_error = _mm256_and_pd(is_quadratic, _mm256_cmp_pd(D_sub, D_sub, _CMP_UNORD_Q));
+        __m256d is_valid = _mm256_andnot_pd(is_error, is_quadratic);
+        __m256d is_negative = _mm256_and_pd(is_valid, _mm256_cmp_pd(D, zero, _CMP_LT_OQ));
+        __m256d is_positive = _mm256_and_pd(is_valid, _mm256_cmp_pd(D, zero, _CMP_GT_OQ));
+        __m256d is_one = _mm256_andnot_pd(_mm256_or_pd(is_negative, is_positive), is_valid);
+        __m256d is_linear = _mm256_andnot_pd(is_quadratic, _mm256_cmp_pd(b, zero, _CMP_NEQ_UQ));
+        __m256d is_c_nonzero = _mm256_cmp_pd(c, zero, _CMP_NEQ_UQ);
+
+        __m256d vertex = _mm256_div_pd(_mm256_div_pd(neg_b, two), a);
+        __m256d root1 = _mm256_div_pd(_mm256_div_pd(_mm256_add_pd(neg_b, s), two), a);
+        __m256d root2 = _mm256_div_pd(_mm256_div_pd(_mm256_sub_pd(neg_b, s), two), a);
+        __m256d imag1 = _mm256_div_pd(_mm256_div_pd(s, two), a);
+        __m256d imag2 = _mm256_div_pd(_mm256_div_pd(neg_s, two), a);
+        __m256d linear = _mm256_div_pd(neg_c, b);
+
+        __m256d re1 = _mm256_and_pd(is_linear, linear);
+        re1 = _mm256_blendv_pd(re1, vertex, _mm256_or_pd(is_negative, is_one));
+        re1 = _mm256_blendv_pd(re1, root1, is_positive);
+        __m256d re2 = _mm256_and_pd(is_negative, vertex);
+        re2 = _mm256_blendv_pd(re2, root2, is_positive);
+        __m256d im1 = _mm256_and_pd(is_negative, imag1);
+        __m256d im2 = _mm256_and_pd(is_negative, imag2);
+
+        // normalize_zero: -0.0 -> 0.0
+        re1 = _mm256_and_pd(re1, _mm256_cmp_pd(re1, zero, _CMP_NEQ_UQ));
+        re2 = _mm256_and_pd(re2, _mm256_cmp_pd(re2, zero, _CMP_NEQ_UQ));
+        im1 = _mm256_and_pd(im1, _mm256_cmp_pd(im1, zero, _CMP_NEQ_UQ));
+        im2 = _mm256_and_pd(im2, _mm256_cmp_pd(im2, zero, _CMP_NEQ_UQ));
+        _mm256_storeu_pd(solutions.re1 + i, re1);
+        _mm256_storeu_pd(solutions.im1 + i, im1);
+        _mm256_storeu_pd(solutions.re2 + i, re2);
+        _mm256_storeu_pd(solutions.im2 + i, im2);
+
+        unsigned quadratic_mask = static_cast<unsigned>(_mm256_movemask_pd(is_quadratic));
+        unsigned error_mask = static_cast<unsigned>(_mm256_movemask_pd(is_error));
+        unsigned negative_mask = static_cast<unsigned>(_mm256_movemask_pd(is_negative));
+        unsigned positive_mask = static_cast<unsigned>(_mm256_movemask_pd(is_positive));
+        unsigned linear_mask = static_cast<unsigned>(_mm256_movemask_pd(is_linear));
+        unsigned c_nonzero_mask = static_cast<unsigned>(_mm256_movemask_pd(is_c_nonzero));
+        for (unsigned lane = 0; lane < 4; ++lane) {
+            solutions.types[i + lane] = Calculator::get_batch_solution_type(
+                    lane, quadratic_mask, error_mask, negative_mask,
+                    positive_mask, linear_mask, c_nonzero_mask);
+        }
+    }
+    return i;
+}
+
+// 8要素ずつ処理し、処理した要素数を返す (残りはscalarで処理する)
+__attribute__((target("avx512f")))
+std::size_t Calculator::solve_quadratic_batch_avx512(
+        const QuadraticSolver::s_coefficient_arrays &coefficients,
+        const QuadraticSolver::s_solution_arrays &solutions,
+        std::size_t size) noexcept(true) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d two = _mm512_set1_pd(2.0);
+    const __m512d four = _mm512_set1_pd(4.0);
+    const __m512i sign = _mm512_set1_epi64(INT64_MIN);
+    std::size_t i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        __m512d a = _mm512_loadu_pd(coefficients.a + i);
+        __m512d b = _mm512_loadu_pd(coefficients.b + i);
+        __m512d c = _mm512_loadu_pd(coefficients.c + i);
+
+        // D = b * b - 4 * a * c (scalarと同じ順序, FMAは使わない)
+        __m512d D = _mm512_sub_pd(_mm512_mul_pd(b, b), _mm512_mul_pd(_mm512_mul_pd(four, a), c));
+        __m512d s = _mm512_maskz_sqrt_pd(0xFF, _mm512_abs_pd(D));
+        __m512d neg_b = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(b), sign));
+        __m512d neg_s = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(s), sign));
+        __m512d neg_c = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(c), sign));
+
+        // D - D はDがnan, infの場合のみnan
+        __m512d D_sub = _mm512_sub_pd(D, D);
+        __mmask8 is_quadratic = _mm512_cmp_pd_mask(a, zero, _CMP_NEQ_UQ);
+        __mmask8 is_error = is_quadratic & _mm512_cmp_pd_mask(D_sub, D_sub, _CMP_UNORD_Q);
+        __mmask8 is_valid = is_quadratic & ~is_error;
+        __mmask8 is_negative = is_valid & _mm512_cmp_pd_mask(D, zero, _CMP_LT_OQ);
+        __mmask8 is_positive = is_valid & _mm512_cmp_pd_mask(D, zero, _CMP_GT_OQ);
+        __mmask8 is_one = is_valid & ~(is_negative | is_positive);
+        __mmask8 is_linear = ~is_quadratic & _mm512_cmp_pd_mask(b, zero, _CMP_NEQ_UQ);
+        __mmask8 is_c_nonzero = _mm512_cmp_pd_mask(c, zero, _CMP_NEQ_UQ);
+
+        __m512d vertex = _mm512_div_pd(_mm512_div_pd(neg_b, two), a);
+        __m512d root1 = _mm512_div_pd(_mm512_div_pd(_mm512_add_pd(neg_b, s), two), a);
+        __m512d root2 = _mm512_div_pd(_mm512_div_pd(_mm512_sub_pd(neg_b, s), two), a);
+        __m512d imag1 = _mm512_div_pd(_mm512_div_pd(s, two), a);
+        __m512d imag2 = _mm512_div_pd(_mm512_div_pd(neg_s, two), a);
+        __m512d linear = _mm512_div_pd(neg_c, b);
+
+        __m512d re1 = _mm512_maskz_mov_pd(is_linear, linear);
+        re1 = _mm512_mask_blend_pd(is_negative | is_one, re1, vertex);
+        re1 = _mm512_mask_blend_pd(is_positive, re1, root1);
+        __m512d re2 = _mm512_maskz_mov_pd(is_negative, vertex);
+        re2 = _mm512_mask_blend_pd(is_positive, re2, root2);
+        __m512d im1 = _mm512_maskz_mov_pd(is_negative, imag1);
+        __m512d im2 = _mm512_maskz_mov_pd(is_negative, imag2);
+
+        // normalize_zero: -0.0 -> 0.0
+        re1 = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(re1, zero, _CMP_NEQ_UQ), re1);
+        re2 = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(re2, zero, _CMP_NEQ_UQ), re2);
+        im1 = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(im1, zero, _CMP_NEQ_UQ), im1);
+        im2 = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(im2, zero, _CMP_NEQ_UQ), im2);
+        _mm512_storeu_pd(solutions.re1 + i, re1);
+        _mm512_storeu_pd(solutions.im1 + i, im1);
+        _mm512_storeu_pd(solutions.re2 + i, re2);
+        _mm512_storeu_pd(solutions.im2 + i, im2);
+
+        for (unsigned lane = 0; lane < 8; ++lane) {
+            solutions.types[i + lane] = Calculator::get_batch_solution_type(
+                    lane, is_quadratic, is_error, is_negative,
+                    is_positive, is_linear, is_c_nonzero);
+        }
+    }
+    return i;
+}
+
+#else
+
+std::size_t Calculator::solve_quadratic_batch_avx2(
+        const QuadraticSolver::s_coefficient_arrays &,
+        const QuadraticSolver::s_solution_arrays &,
+        std::size_t) noexcept(true) {
+    return 0;
+}
+
+std::size_t Calculator::solve_quadratic_batch_avx512(
+        const QuadraticSolver::s_coefficient_arrays &,
+        const QuadraticSolver::s_solution_arrays &,
+        std::size_t) noexcept(true) {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include "CharClass.hpp"
+#include <atomic>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+#endif
+#include "computor.hpp"
+
+namespace CharClass {
+
+namespace {
+
+std::atomic<ClassifyFunc> g_classify(nullptr);
+std::atomic<Kernel> g_kernel(Scalar);
+
+ClassifyFunc get_classify_func(Kernel kernel) noexcept(true) {
+    switch (kernel) {
+#if defined(__x86_64__) || defined(__i386__)
+        case AVX2:
+            return classify_avx2;
+        case SSE2:
+            return classify_sse2;
+#endif
+        default:
+            return classify_scalar;
+    }
+}
+
+}  // namespace
+
+void classify(const char *block, std::size_t len, Masks *masks) noexcept(true) {
+    ClassifyFunc func = g_classify.load(std::memory_order_relaxed);
+    if (!func) {
+        set_kernel(detect_kernel());
+        func = g_classify.load(std::memory_order_relaxed);
+    }
+    func(block, len, masks);
+}
+
+// 実行中のCPUが対応する最速のkernel
+Kernel detect_kernel() noexcept(true) {
+    if (is_supported(AVX2)) { return AVX2; }
+    if (is_supported(SSE2)) { return SSE2; }
+    return Scalar;
+}
+
+Kernel kernel() noexcept(true) {
+    if (!g_classify.load(std::memory_order_relaxed)) {
+        set_kernel(detect_kernel());
+    }
+    return g_kernel.load(std::memory_order_relaxed);
+}
+
+// test, benchmark用. 非対応のkernelは選択しない
+bool set_kernel(Kernel kernel) noexcept(true) {
+    if (!is_supported(kernel)) {
+        return false;
+    }
+    g_kernel.store(kernel, std::memory_order_relaxed);
+    g_classify.store(get_classify_func(kernel), std::memory_order_relaxed);
+    return true;
+}
+
+bool is_supported(Kernel kernel) noexcept(true) {
+    switch (kernel) {
+        case Scalar:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case SSE2:
+            return __builtin_cpu_supports("sse2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+const char *kernel_name(Kernel kernel) noexcept(true) {
+    switch (kernel) {
+        case Scalar:
+            return "scalar";
+        case SSE2:
+            return "sse2";
+        case AVX2:
+            return "avx2";
+        default:
+            return "unknown";
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+void classify_scalar(const char *block, std::size_t len, Masks *masks) noexcept(true) {
+    if (!masks) { return; }
+
+    Masks result = {};
+    if (kBlockSize < len) {
+        len = kBlockSize;
+    }
+    for (std::size_t i = 0; i < len; ++i) {
+        char c = block[i];
+        std::uint64_t bit = std::uint64_t(1) << i;
+
+        if ('0' <= c && c <= '9') {
+            result.digit |= bit;
+        } else if (('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z')) {
+            result.alpha |= bit;
+        } else if (c == Computor::SP) {
+            result.space |= bit;
+        } else if (c == '.') {
+            result.dot |= bit;
+        } else if (c == Computor::OP_PLUS
+                   || c == Computor::OP_MINUS
+                   || c == Computor::OP_MUL
+                   || c == Computor::OP_EQUAL
+                   || c == Computor::OP_POW) {
+            result.op |= bit;
+        }
+    }
+    *masks = result;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// signed比較のため、0x80以上のbyteはいずれの文字種にも該当しない
+// alpha: c | 0x20 で大文字を小文字に寄せて 'a' <= c <= 'z' を判定
+__attribute__((target("sse2")))
+void classify_sse2(const char *block, std::size_t len, Masks *masks) noexcept(true) {
+    if (!masks) { return; }
+
+    alignas(16) char padded[kBlockSize];
+    const char *src = block;
+    if (len < kBlockSize) {
+        std::memset(padded, 0, kBlockSize);
+        std::memcpy(padded, block, len);
+        src = padded;
+    }
+
+    Masks result = {};
+    for (std::size_t i = 0; i < kBlockSize; i += 16) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+        __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                      _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i space = _mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::SP));
+        __m128i dot = _mm_cmpeq_epi8(c, _mm_set1_epi8('.'));
+        __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::OP_PLUS)),
+                             _mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::OP_MINUS))),
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::OP_MUL)),
+                                          _mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::OP_EQUAL))),
+                             _mm_cmpeq_epi8(c, _mm_set1_epi8(Computor::OP_POW))));
+
+        result.digit |= static_cast<std::uint64_t>(_mm_movemask_epi8(digit) & 0xFFFF) << i;
+        result.alpha |= static_cast<std::uint64_t>(_mm_movemask_epi8(alpha) & 0xFFFF) << i;
+        result.space |= static_cast<std::uint64_t>(_mm_movemask_epi8(space) & 0xFFFF) << i;
+        result.dot |= static_cast<std::uint64_t>(_mm_movemask_epi8(dot) & 0xFFFF) << i;
+        result.op |= static_cast<std::uint64_t>(_mm_movemask_epi8(op) & 0xFFFF) << i;
+    }
+    *masks = result;
+}
+
+__attribute__((target("avx2")))
+void classify_avx2(const char *block, std::size_t len, Masks *masks) noexcept(true) {
+    if (!masks) { return; }
+
+    alignas(32) char padded[kBlockSize];
+    const char *src = block;
+    if (len < kBlockSize) {
+        std::memset(padded, 0, kBlockSize);
+        std::memcpy(padded, block, len);
+        src = padded;
+    }
+
+    Masks result = {};
+    for (std::size_t i = 0; i < kBlockSize; i += 32) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+        __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i space = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::SP));
+        __m256i dot = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('.'));
+        __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::OP_PLUS)),
+                                _mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::OP_MINUS))),
+                _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::OP_MUL)),
+                                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::OP_EQUAL))),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8(Computor::OP_POW))));
+
+        result.digit |= static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(digit))) << i;
+        result.alpha |= static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(alpha))) << i;
+        result.space |= static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(space))) << i;
+        result.dot |= static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(dot))) << i;
+        result.op |= static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(op))) << i;
+    }
+    *masks = result;
+}
+
+#endif
+
+}  // namespace CharClass
@@ -0,0 +1,43 @@
+#pragma once
+
+# include <cstddef>
+# include <cstdint>
+
+// 入力を64byteのblock単位で分類し、文字種ごとのbitmaskを返す
+//   bit i: block[i]がその文字種
+//   block長が64未満の場合、len以降のbitは0
+namespace CharClass {
+
+constexpr std::size_t kBlockSize = 64;
+
+enum Kernel {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+struct Masks {
+    std::uint64_t digit;  // 0-9
+    std::uint64_t alpha;  // A-Z, a-z
+    std::uint64_t space;  // SP
+    std::uint64_t dot;    // .
+    std::uint64_t op;     // + - * = ^
+};
+
+using ClassifyFunc = void (*)(const char *block, std::size_t len, Masks *masks);
+
+void classify(const char *block, std::size_t len, Masks *masks) noexcept(true);
+
+Kernel detect_kernel() noexcept(true);
+Kernel kernel() noexcept(true);
+bool set_kernel(Kernel kernel) noexcept(true);
+bool is_supported(Kernel kernel) noexcept(true);
+const char *kernel_name(Kernel kernel) noexcept(true);
+
+void classify_scalar(const char *block, std::size_t len, Masks *masks) noexcept(true);
+#if defined(__x86_64__) || defined(__i386__)
+void classify_sse2(const char *block, std::size_t len, Masks *masks) noexcept(true);
+void classify_avx2(const char *block, std::size_t len, Masks *masks) noexcept(true);
+#endif
+
+}  // namespace CharClass
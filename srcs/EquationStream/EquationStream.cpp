@@ -0,0 +1,130 @@
+#include "EquationStream.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// 項の境界. 境界の文字は常に1文字のtokenのため、直前で区切ってもtokenは分断されない
+constexpr char kTermBoundary[] = {
+        Computor::OP_PLUS,
+        Computor::OP_MINUS,
+        Computor::OP_EQUAL,
+        '\0'
+};
+
+}  // namespace
+
+EquationStream::EquationStream(std::size_t chunk_size)
+    : chunk_size_(std::max<std::size_t>(chunk_size, 1)),
+      tokenizer_(),
+      buffer_() {}
+
+EquationStream::~EquationStream() {}
+
+Result<Polynomials, ErrMsg> EquationStream::parse(
+        std::istream &in,
+        Parser *parser) noexcept(true) {
+    if (!parser) {
+        return Result<Polynomials, ErrMsg>::err("invalid equation");
+    }
+    EquationStream::begin(parser);
+    this->buffer_.clear();
+
+    while (true) {
+        std::size_t carry = this->buffer_.size();
+        this->buffer_.resize(carry + this->chunk_size_);
+        in.read(&this->buffer_[carry], static_cast<std::streamsize>(this->chunk_size_));
+        std::size_t read_size = static_cast<std::size_t>(in.gcount());
+        this->buffer_.resize(carry + read_size);
+        if (in.bad()) {
+            return Result<Polynomials, ErrMsg>::err("cannot read input");
+        }
+        if (read_size < this->chunk_size_) {
+            break;
+        }
+
+        // 持ち越した範囲には先頭以外に境界が無いため、今回読んだ範囲のみ探す
+        std::size_t search_begin = std::max<std::size_t>(carry, 1);
+        std::string_view unread = std::string_view(this->buffer_).substr(search_begin);
+        std::size_t cut = unread.find_last_of(kTermBoundary);
+        if (cut == std::string_view::npos) {
+            continue;
+        }
+        cut += search_begin;
+
+        std::string_view segment = std::string_view(this->buffer_).substr(0, cut);
+        Result<Computor::Status, ErrMsg> segment_result;
+        segment_result = EquationStream::parse_segment(segment, parser);
+        if (segment_result.is_err()) {
+            return Result<Polynomials, ErrMsg>::err(std::move(segment_result).err_value());
+        }
+        this->buffer_.erase(0, cut);
+    }
+
+    std::string_view last_segment = Computor::trim_newline(this->buffer_);
+    Result<Computor::Status, ErrMsg> segment_result;
+    segment_result = EquationStream::parse_segment(last_segment, parser);
+    if (segment_result.is_err()) {
+        return Result<Polynomials, ErrMsg>::err(std::move(segment_result).err_value());
+    }
+    return parser->end_equation();
+}
+
+Result<Polynomials, ErrMsg> EquationStream::parse(
+        std::string_view equation,
+        Parser *parser) noexcept(true) {
+    if (!parser) {
+        return Result<Polynomials, ErrMsg>::err("invalid equation");
+    }
+    EquationStream::begin(parser);
+    equation = Computor::trim_newline(equation);
+
+    std::size_t begin = 0;
+    while (this->chunk_size_ < equation.length() - begin) {
+        // [begin, begin + chunk_size]の最後の境界で区切る. 無ければchunk_sizeより長い項
+        std::size_t limit = begin + this->chunk_size_;
+        std::size_t cut = equation.find_last_of(kTermBoundary, limit);
+        if (cut == std::string_view::npos || cut <= begin) {
+            cut = equation.find_first_of(kTermBoundary, limit + 1);
+        }
+        if (cut == std::string_view::npos) {
+            break;
+        }
+
+        Result<Computor::Status, ErrMsg> segment_result;
+        segment_result = EquationStream::parse_segment(equation.substr(begin, cut - begin), parser);
+        if (segment_result.is_err()) {
+            return Result<Polynomials, ErrMsg>::err(std::move(segment_result).err_value());
+        }
+        begin = cut;
+    }
+
+    Result<Computor::Status, ErrMsg> segment_result;
+    segment_result = EquationStream::parse_segment(equation.substr(begin), parser);
+    if (segment_result.is_err()) {
+        return Result<Polynomials, ErrMsg>::err(std::move(segment_result).err_value());
+    }
+    return parser->end_equation();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+void EquationStream::begin(Parser *parser) noexcept(true) {
+    this->tokenizer_.reset();
+    parser->begin_equation();
+}
+
+// parserのerrorはend_equation()で返す
+// 以降のsegmentもlexを続け、tokenizerのerrorを優先する
+Result<Computor::Status, ErrMsg> EquationStream::parse_segment(
+        std::string_view segment,
+        Parser *parser) noexcept(true) {
+    Result<Computor::Status, ErrMsg> lex_result = this->tokenizer_.lex_segment(segment);
+    if (lex_result.is_err()) {
+        return lex_result;
+    }
+    parser->parse_tokens(this->tokenizer_.token_stream());
+    return Result<Computor::Status, ErrMsg>::ok(Computor::Status::SUCCESS);
+}
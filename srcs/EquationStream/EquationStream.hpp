@@ -0,0 +1,39 @@
+#pragma once
+
+# include <cstddef>
+# include <istream>
+# include <string>
+# include <string_view>
+# include "computor.hpp"
+# include "Parser.hpp"
+# include "Result.hpp"
+# include "Tokenizer.hpp"
+
+// 方程式を項の境界 (+, -, =の直前) でsegmentに区切り、segmentごとにlex, parseする
+// 項はparserの多項式へ順に加算され、保持するのは1 segment分の入力とtoken、多項式のみ
+//   "2 * X^2 + 1 = 0" -> ["2 * X^2 "]["+ 1 "]["= 0"]
+// errorはparse_equation()と同じ. tokenizerのerrorはparserのerrorより優先する
+class EquationStream {
+ public:
+    explicit EquationStream(std::size_t chunk_size = Computor::STREAM_CHUNK_SIZE);
+    ~EquationStream();
+
+    // inをchunk_sizeずつ読む. 項の途中で切れたchunkの末尾は次のchunkへ持ち越す
+    Result<Polynomials, ErrMsg> parse(std::istream &in, Parser *parser) noexcept(true);
+    // equationをコピーせず、chunk_size程度のsegmentに区切る
+    Result<Polynomials, ErrMsg> parse(std::string_view equation, Parser *parser) noexcept(true);
+
+ private:
+    std::size_t chunk_size_;
+    Tokenizer tokenizer_;
+    std::string buffer_;
+
+    void begin(Parser *parser) noexcept(true);
+    Result<Computor::Status, ErrMsg> parse_segment(
+            std::string_view segment,
+            Parser *parser) noexcept(true);
+
+    // copy invalid
+    EquationStream &operator=(const EquationStream &rhs);
+    EquationStream(const EquationStream &other);
+};
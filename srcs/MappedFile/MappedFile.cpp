@@ -0,0 +1,65 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+MappedFile::MappedFile() : addr_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() {
+    MappedFile::close();
+}
+
+Result<Computor::Status, ErrMsg> MappedFile::open(const std::string &path) noexcept(true) {
+    MappedFile::close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::string err_msg = "cannot open file: " + path + ": " + std::strerror(errno);
+        return Result<Computor::Status, ErrMsg>::err(err_msg);
+    }
+
+    struct stat file_stat = {};
+    if (fstat(fd, &file_stat) < 0 || !S_ISREG(file_stat.st_mode)) {
+        std::string err_msg = "cannot open file: " + path + ": not a regular file";
+        ::close(fd);
+        return Result<Computor::Status, ErrMsg>::err(err_msg);
+    }
+
+    // 空fileはmmapできないため、空のdataとして扱う
+    std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return Result<Computor::Status, ErrMsg>::ok(Computor::Status::SUCCESS);
+    }
+
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::string err_msg = "cannot map file: " + path + ": " + std::strerror(errno);
+        return Result<Computor::Status, ErrMsg>::err(err_msg);
+    }
+    // 先頭から1度だけ読むため、読み終えたpageは早めに解放されてよい
+    madvise(addr, size, MADV_SEQUENTIAL);
+
+    this->addr_ = addr;
+    this->size_ = size;
+    return Result<Computor::Status, ErrMsg>::ok(Computor::Status::SUCCESS);
+}
+
+void MappedFile::close() noexcept(true) {
+    if (this->addr_) {
+        munmap(this->addr_, this->size_);
+    }
+    this->addr_ = nullptr;
+    this->size_ = 0;
+}
+
+std::string_view MappedFile::data() const noexcept(true) {
+    if (!this->addr_) {
+        return std::string_view();
+    }
+    return std::string_view(static_cast<const char *>(this->addr_), this->size_);
+}
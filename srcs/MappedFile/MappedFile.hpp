@@ -0,0 +1,27 @@
+#pragma once
+
+# include <cstddef>
+# include <string>
+# include <string_view>
+# include "computor.hpp"
+# include "Result.hpp"
+
+// fileをread-onlyでmmapし、内容をコピーせずに参照する
+// data()はMappedFileの生存中のみ有効
+class MappedFile {
+ public:
+    MappedFile();
+    ~MappedFile();
+
+    Result<Computor::Status, ErrMsg> open(const std::string &path) noexcept(true);
+    void close() noexcept(true);
+    std::string_view data() const noexcept(true);
+
+ private:
+    void *addr_;
+    std::size_t size_;
+
+    // copy invalid
+    MappedFile &operator=(const MappedFile &rhs);
+    MappedFile(const MappedFile &other);
+};
@@ -0,0 +1,67 @@
+#include "OutputBuffer.hpp"
+#include <charconv>
+#include <ostream>
+
+namespace {
+
+// "-1.23457e-308" の長さに余裕を持たせる
+constexpr std::size_t kNumberChars = 32;
+constexpr int kDoublePrecision = 6;
+
+}  // namespace
+
+OutputBuffer::OutputBuffer() : buffer_() {}
+
+OutputBuffer::~OutputBuffer() {}
+
+void OutputBuffer::append(std::string_view str) noexcept(false) {
+    this->buffer_.append(str);
+}
+
+void OutputBuffer::append(char c) noexcept(false) {
+    this->buffer_.push_back(c);
+}
+
+void OutputBuffer::append(std::int32_t num) noexcept(false) {
+    char chars[kNumberChars];
+    std::to_chars_result result = std::to_chars(chars, chars + kNumberChars, num);
+    this->buffer_.append(chars, result.ptr);
+}
+
+void OutputBuffer::append(std::uint64_t num) noexcept(false) {
+    char chars[kNumberChars];
+    std::to_chars_result result = std::to_chars(chars, chars + kNumberChars, num);
+    this->buffer_.append(chars, result.ptr);
+}
+
+// out << num と同じ (printfの%.6g. inf, nan, -0も同じ表記)
+void OutputBuffer::append(double num) noexcept(false) {
+    char chars[kNumberChars];
+    std::to_chars_result result = std::to_chars(
+            chars, chars + kNumberChars, num, std::chars_format::general, kDoublePrecision);
+    this->buffer_.append(chars, result.ptr);
+}
+
+std::string_view OutputBuffer::view() const noexcept(true) {
+    return this->buffer_;
+}
+
+std::size_t OutputBuffer::size() const noexcept(true) {
+    return this->buffer_.size();
+}
+
+bool OutputBuffer::empty() const noexcept(true) {
+    return this->buffer_.empty();
+}
+
+void OutputBuffer::clear() noexcept(true) {
+    this->buffer_.clear();
+}
+
+void OutputBuffer::write_to(std::ostream &out) noexcept(true) {
+    if (!this->buffer_.empty()) {
+        out.write(this->buffer_.data(), static_cast<std::streamsize>(this->buffer_.size()));
+    }
+    out.flush();
+    this->buffer_.clear();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+# include <cstddef>
+# include <cstdint>
+# include <iosfwd>
+# include <string>
+# include <string_view>
+
+// 出力を貯めるbuffer. clear()してもcapacityは保持し、方程式, batchのchunkをまたいで再利用する
+// 数値はstd::to_charsで書き、std::ostreamの既定の書式 (double: %g 精度6) と同じ文字列にする
+class OutputBuffer {
+ public:
+    OutputBuffer();
+    ~OutputBuffer();
+
+    void append(std::string_view str) noexcept(false);
+    void append(char c) noexcept(false);
+    void append(std::int32_t num) noexcept(false);
+    void append(std::uint64_t num) noexcept(false);
+    void append(double num) noexcept(false);
+
+    std::string_view view() const noexcept(true);
+    std::size_t size() const noexcept(true);
+    bool empty() const noexcept(true);
+    void clear() noexcept(true);
+
+    // 貯めた内容を1回のwriteで書き込み、clear()する
+    void write_to(std::ostream &out) noexcept(true);
+
+ private:
+    std::string buffer_;
+
+    // copy invalid
+    OutputBuffer &operator=(const OutputBuffer &rhs);
+    OutputBuffer(const OutputBuffer &other);
+};
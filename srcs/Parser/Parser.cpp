@@ -2,9 +2,20 @@
 #include <deque>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
-
-Parser::Parser() : polynomial_(), variable_() {
+#include <limits>
+#include <utility>
+
+Parser::Parser() : Parser(std::pmr::get_default_resource()) {}
+
+Parser::Parser(std::pmr::memory_resource *resource)
+    : memory_resource_(resource),
+      polynomial_(resource),
+      variable_(),
+      is_lhs_(true),
+      term_count_(0),
+      error_(),
+      stats_(nullptr),
+      counts_() {
     // for (int i = 0; i <= this->max_degree_; ++i) {
     //     this->polynomial_[i] = 0;
     // }
@@ -15,55 +26,194 @@ Parser::~Parser() {}
 // equation:  A0 * X^0 + A1 * X^1 + A2 * X^2 = 0
 // tokens  : [A0][*][X][^][0][+][A1][*][X][^][1][+][A2][*][X][^][2][=][0]
 Result<Polynomials, ErrMsg> Parser::parse_equation(
-        const Tokens &tokens) noexcept(true) {
-    // token -> term
-    auto current = tokens.cbegin();
-    auto end = tokens.cend();
-    auto begin = current;
+        const TokenStream &tokens) noexcept(true) {
+    Parser::begin_equation();
+    Parser::parse_tokens(tokens);
+    return Parser::end_equation();
+}
 
-    if (tokens.empty()) {
-        std::string err_msg = error_message(&current, end);
-        return Result<Polynomials, ErrMsg>::err(err_msg);
-    }
-    parse_expression(&current, end, true);
-    if (current == begin || Parser::is_at_end(&current, end)) {
-        std::string err_msg = error_message(&current, end);
-        return Result<Polynomials, ErrMsg>::err(err_msg);
+Result<Polynomials, ErrMsg> Parser::parse_equation(const Tokens &tokens) noexcept(true) {
+    std::pmr::string source(this->memory_resource_);
+    TokenStream stream(this->memory_resource_);
+
+    stream.assign(tokens, &source);
+    return Parser::parse_equation(stream);
+}
+
+void Parser::begin_equation() noexcept(true) {
+    this->is_lhs_ = true;
+    this->term_count_ = 0;
+    this->error_.clear();
+    this->counts_ = {};
+}
+
+//  lhs                              rhs
+//  vvvvvvvvvvvvvvvvvvvvvvvvvvvvvv   v
+//  A0 * X^0 + A1 * X^1 + A2 * X^2 = 0
+//           ^先頭以外の項は、parse前に符号評価
+// 項はparseした順にpolynomial_へ加算する. tokensは項の途中で分割しないこと
+// errorはend_equation()まで保持し、以降のtokensは読み飛ばす
+Result<Computor::Status, ErrMsg> Parser::parse_tokens(const TokenStream &tokens) noexcept(true) {
+    std::size_t current = 0;
+
+    if constexpr (Stats::kEnabled) {
+        this->counts_.tokens += tokens.size();
+    }
+    while (this->error_.empty() && !Parser::is_at_end(tokens, current)) {
+        if (this->term_count_ != 0) {
+            if (this->is_lhs_ && Parser::consume(tokens, &current, OperatorEqual)) {
+                this->is_lhs_ = false;
+                this->term_count_ = 0;
+                continue;
+            }
+            if (!Parser::expect(tokens, current, OperatorPlus)
+                && !Parser::expect(tokens, current, OperatorMinus)) {
+                this->error_ = error_message(tokens, current);
+                break;
+            }
+        } else if (!Parser::is_expression_begin(tokens, current)) {
+            this->error_ = error_message(tokens, current);
+            break;
+        }
+
+        // parse term
+        std::size_t begin = current;
+        Result<s_term, Computor::Status> result = Parser::parse_term(tokens, &current);
+        if (result.is_err()) {
+            this->error_ = error_message(tokens, begin);
+            break;
+        }
+
+        // validate term
+        if (Parser::set_valid_term(result.ok_value(), this->is_lhs_) == Computor::Status::FAILURE) {
+            this->error_ = error_message(tokens, begin);
+            break;
+        }
+        ++this->term_count_;
     }
-    if (!Parser::consume(&current, end, OperatorEqual)) {
-        std::string err_msg = error_message(&current, end);
-        return Result<Polynomials, ErrMsg>::err(err_msg);
+
+    if (!this->error_.empty()) {
+        return Result<Computor::Status, ErrMsg>::err(this->error_);
     }
+    return Result<Computor::Status, ErrMsg>::ok(Computor::Status::SUCCESS);
+}
 
-    begin = current;
-    parse_expression(&current, end, false);
-    if (current == begin || !Parser::is_at_end(&current, end)) {
-        std::string err_msg = error_message(&current, end);
-        return Result<Polynomials, ErrMsg>::err(err_msg);
+Result<Polynomials, ErrMsg> Parser::end_equation() noexcept(true) {
+    if (this->error_.empty() && (this->is_lhs_ || this->term_count_ == 0)) {
+        this->error_ = "invalid equation";
+    }
+    if (!this->error_.empty()) {
+        return Result<Polynomials, ErrMsg>::err(this->error_);
     }
 
     // valid poly, nan, inf, etc...
     Result<Computor::Status, ErrMsg> validate_result = Parser::validate();
     if (validate_result.is_err()) {
-        std::string err_msg = validate_result.err_value();
-        return Result<Polynomials, ErrMsg>::err(err_msg);
+        return Result<Polynomials, ErrMsg>::err(std::move(validate_result).err_value());
     }
 
     Parser::reduce();
     return Result<Polynomials, ErrMsg>::ok(this->polynomial_);
 }
 
-void Parser::display_reduced_form() const noexcept(true) {
-    std::cout << "Reduced form     : " << Parser::reduced_form() << std::endl;
+// parse_tokens()と同じ文法をtokenを作らずに判定し、項をpolynomial_へ加算する
+// tokenize()がerrorとする入力 (不正なword, 異なるbase char) もFAILUREとする
+//   "2X^2 + 1 = 0": [2][X][^][2] -> term -> polynomial_, [+][1] -> term -> ...
+Computor::Status Parser::recognize_equation(std::string_view equation) noexcept(true) {
+    if (equation.empty() || std::numeric_limits<std::uint32_t>::max() < equation.length()) {
+        return Computor::Status::FAILURE;
+    }
+    s_scanner scanner = {};
+    scanner.source = equation;
+
+    Parser::begin_equation();
+    Computor::Status status = Parser::recognize_terms(&scanner);
+    if constexpr (Stats::kEnabled) {
+        this->counts_.tokens = scanner.tokens;
+    }
+    return status;
 }
 
-void Parser::display_polynomial_degree() const noexcept(true) {
+// 全ての項をpolynomial_へ加算し、validate, reduceする
+Computor::Status Parser::recognize_terms(s_scanner *scanner) noexcept(true) {
+    Parser::scan_next(scanner);
+    while (!scanner->is_end) {
+        if (this->term_count_ != 0) {
+            if (this->is_lhs_ && scanner->kind == OperatorEqual) {
+                this->is_lhs_ = false;
+                this->term_count_ = 0;
+                Parser::scan_next(scanner);
+                continue;
+            }
+            if (scanner->kind != OperatorPlus && scanner->kind != OperatorMinus) {
+                return Computor::Status::FAILURE;
+            }
+        } else if (!Parser::is_expression_begin(*scanner)) {
+            return Computor::Status::FAILURE;
+        }
+
+        s_term term = {};
+        if (Parser::recognize_term(scanner, &term) == Computor::Status::FAILURE) {
+            return Computor::Status::FAILURE;
+        }
+        if (Parser::set_valid_term(term, this->is_lhs_) == Computor::Status::FAILURE) {
+            return Computor::Status::FAILURE;
+        }
+        ++this->term_count_;
+    }
+    if (this->is_lhs_ || this->term_count_ == 0) {
+        return Computor::Status::FAILURE;
+    }
+    if (Parser::validate().is_err()) {
+        return Computor::Status::FAILURE;
+    }
+    Parser::reduce();
+    return Computor::Status::SUCCESS;
+}
+
+// parse前の状態に戻す. polynomial_, variable_も初期化する
+// polynomial_のdenseな項 (0 <= degree < kDenseSize) はheapを使わないため、再利用で確保は発生しない
+void Parser::reset() noexcept(true) {
+    this->polynomial_.clear();
+    this->variable_ = '\0';
+    Parser::begin_equation();
+}
+
+void Parser::set_stats(Stats *stats) noexcept(true) {
+    this->stats_ = stats;
+}
+
+const s_parse_counts &Parser::counts() const noexcept(true) {
+    return this->counts_;
+}
+
+void Parser::display_reduced_form(std::ostream &out) const noexcept(true) {
+    OutputBuffer buffer;
+    Parser::format_reduced_form(&buffer);
+    buffer.write_to(out);
+}
+
+void Parser::display_polynomial_degree(std::ostream &out) const noexcept(true) {
+    OutputBuffer buffer;
+    Parser::format_polynomial_degree(&buffer);
+    buffer.write_to(out);
+}
+
+void Parser::format_reduced_form(OutputBuffer *out) const noexcept(true) {
+    out->append("Reduced form     : ");
+    Parser::append_reduced_form(this->polynomial_, out);
+    out->append('\n');
+}
+
+void Parser::format_polynomial_degree(OutputBuffer *out) const noexcept(true) {
     auto itr = this->polynomial_.crbegin();
     if (itr == this->polynomial_.crend()) {
         return;
     }
     std::int32_t max_degree = itr->first;
-    std::cout << "Polynomial degree: " << max_degree << std::endl;
+    out->append("Polynomial degree: ");
+    out->append(max_degree);
+    out->append('\n');
 }
 
 const Polynomials &Parser::polynomial() const noexcept(true) {
@@ -71,7 +221,9 @@ const Polynomials &Parser::polynomial() const noexcept(true) {
 }
 
 std::string Parser::reduced_form() const noexcept(true) {
-    return Parser::reduced_form(this->polynomial_);
+    OutputBuffer buffer;
+    Parser::append_reduced_form(this->polynomial_, &buffer);
+    return std::string(buffer.view());
 }
 
 
@@ -96,6 +248,7 @@ Result<Computor::Status, ErrMsg> Parser::validate() noexcept(true) {
 }
 
 void Parser::reduce() noexcept(true) {
+    Stats::Timer timer(this->stats_, Stats::Reduce);
     // std::cout << "before: ";
     // Parser::display_reduced_form();
     Parser::drop_zero_term();
@@ -109,18 +262,17 @@ void Parser::reduce() noexcept(true) {
 // delete term; coef == 0.0
 // min poly: {0, 0}
 void Parser::drop_zero_term() noexcept(true) {
-    Polynomials new_poly;
-
-    for (auto poly : this->polynomial_) {
-        std::int32_t pow = poly.first;
-        double coef = poly.second;
-        if (coef == 0.0) { continue; }
-        new_poly[pow] = coef;
+    for (auto itr = this->polynomial_.begin(); itr != this->polynomial_.end();) {
+        double coef = itr->second;
+        if (coef == 0.0) {
+            itr = this->polynomial_.erase(itr);
+            continue;
+        }
+        ++itr;
     }
-    if (new_poly.empty()) {
-        new_poly[0] = 0.0;
+    if (this->polynomial_.empty()) {
+        this->polynomial_[0] = 0.0;
     }
-    this->polynomial_ = new_poly;
 }
 
 // 最大次元の係数を正とするよう符号を調整
@@ -188,7 +340,14 @@ Computor::Status Parser::set_valid_term(const s_term &term, bool is_lhs) noexcep
     if (!Parser::is_valid_variable(var, degree)) {
         return Computor::Status::FAILURE;
     }
-    this->polynomial_[degree] += (is_lhs ? 1 : -1) * coef;
+    if constexpr (Stats::kEnabled) {
+        std::size_t size = this->polynomial_.size();
+        this->polynomial_[degree] += (is_lhs ? 1 : -1) * coef;
+        ++this->counts_.terms;
+        this->counts_.insertions += this->polynomial_.size() - size;
+    } else {
+        this->polynomial_[degree] += (is_lhs ? 1 : -1) * coef;
+    }
     // if (!Parser::is_valid_coef(this->polynomial_[degree])) {  // todo: unnecessary?
     //     // std::cerr << "[Error] invalid coefficient, too large or too small" << std::endl;
     //     return Computor::Status::FAILURE;
@@ -197,65 +356,37 @@ Computor::Status Parser::set_valid_term(const s_term &term, bool is_lhs) noexcep
 }
 
 std::string Parser::error_message(
-        TokenItr *current,
-        const TokenItr &end) noexcept(true) {
-    if (Parser::is_at_end(current, end)) {
+        const TokenStream &tokens,
+        std::size_t current) noexcept(true) {
+    if (Parser::is_at_end(tokens, current)) {
         return "invalid equation";
     } else {
-        return "syntax error: unexpected token near: " + (*current)->word;
+        return "syntax error: unexpected token near: " + std::string(tokens.word(current));
     }
 }
 
-//  lhs                              rhs
-//  vvvvvvvvvvvvvvvvvvvvvvvvvvvvvv   v
-//  A0 * X^0 + A1 * X^1 + A2 * X^2 = 0
-//           ^先頭以外の項は、parse前に符号評価
-void Parser::parse_expression(
-        TokenItr *current,
-        const TokenItr &end,
-        bool is_lhs) noexcept(true) {
-    if (!Parser::expect(current, end, Char)
-        && !Parser::expect(current, end, Integer)
-        && !Parser::expect(current, end, Decimal)
-        && !Parser::expect(current, end, OperatorPlus)
-        && !Parser::expect(current, end, OperatorMinus)) {
-        return;
-    }
-    while (!Parser::is_at_end(current, end)) {
-        // parse term
-        auto begin = *current;
-        Result<s_term, Computor::Status> result = Parser::parse_term(current, end);
-        if (result.is_err()) {
-            *current = begin;
-            return;
-        }
-        s_term term = result.ok_value();
-
-        // validate term
-        if (Parser::set_valid_term(term, is_lhs) == Computor::Status::FAILURE) {
-            *current = begin;
-            return;
-        }
-
-        if (Parser::expect(current, end, OperatorPlus)
-        || Parser::expect(current, end, OperatorMinus)) {
-            continue;
-        }
-        break;
-    }
+// expressionの先頭のtoken: 係数, 変数, 符号
+bool Parser::is_expression_begin(
+        const TokenStream &tokens,
+        std::size_t current) noexcept(true) {
+    return Parser::expect(tokens, current, Char)
+        || Parser::expect(tokens, current, Integer)
+        || Parser::expect(tokens, current, Decimal)
+        || Parser::expect(tokens, current, OperatorPlus)
+        || Parser::expect(tokens, current, OperatorMinus);
 }
 
 bool Parser::is_at_end(
-        TokenItr *current,
-        const TokenItr &end) noexcept(true) {
-    return *current == end;
+        const TokenStream &tokens,
+        std::size_t current) noexcept(true) {
+    return tokens.size() <= current;
 }
 
 bool Parser::consume(
-        TokenItr *current,
-        const TokenItr &end,
+        const TokenStream &tokens,
+        std::size_t *current,
         TokenKind expected_kind) noexcept(true) {
-    if (expect(current, end, expected_kind)) {
+    if (expect(tokens, *current, expected_kind)) {
         ++(*current);
         return true;
     }
@@ -263,78 +394,16 @@ bool Parser::consume(
 }
 
 bool Parser::expect(
-        TokenItr *current,
-        const TokenItr &end,
+        const TokenStream &tokens,
+        std::size_t current,
         TokenKind expected_kind) noexcept(true) {
-    return *current != end && (*current)->kind == expected_kind;
+    return current < tokens.size() && tokens.kind(current) == expected_kind;
 }
 
-std::pair<Computor::Status, double> Parser::stod(const std::string &word) noexcept(true) {
-    std::pair<Computor::Status, double> result;
-    result.first = Computor::FAILURE;
-
-    if (word.empty() || !std::isdigit(word[0])) {
-        return result;
-    }
-    try {
-        std::size_t end;
-        double dnum = std::stod(word, &end);
-        if (end < word.length()) {
-            return result;
-        }
-        result.first = Computor::SUCCESS;
-        result.second = dnum;
-        return result;
-    } catch (const std::exception &e) {
-        // out of range, invalid argument
-        return result;
-    }
-}
-
-std::pair<Computor::Status, std::int32_t> Parser::stoi(const std::string &word) noexcept(true) {
-    std::pair<Computor::Status, std::int32_t> result;
-    result.first = Computor::FAILURE;
-
-    if (word.empty() || !std::isdigit(word[0])) {
-        return result;
-    }
-    try {
-        std::size_t end;
-        std::int32_t inum = std::stoi(word, &end);
-        if (end < word.length()) {
-            return result;
-        }
-        result.first = Computor::SUCCESS;
-        result.second = inum;
-        return result;
-    } catch (const std::exception &e) {
-        // out of range, invalid argument
-        return result;
-    }
-}
-
-/*
-    enum TokenKind {
-        None = 0,
-        TermCoef,       // aX^b a
-        TermBase,       // aX^b X
-        TermPowSymbol,  // aX^b ^
-        TermPower,      // aX^b b
-        OperatorPlus,   // +
-        OperatorMinus,  // -
-        OperatorMul,    // *
-        OperatorEqual,  // =
-    };
-
-    struct s_token {
-        std::string word;
-        TokenKind kind;
-    };
- */
 // term = ( operator ) [ coefficient ("*") ] ALPHA "^" 1*( DIGIT )
 Result<s_term, Computor::Status> Parser::parse_term(
-        TokenItr *current,
-        const TokenItr &end) noexcept(true) {
+        const TokenStream &tokens,
+        std::size_t *current) noexcept(true) {
     s_term term = {};
     double coefficient;
     char variable = '\0';
@@ -344,13 +413,14 @@ Result<s_term, Computor::Status> Parser::parse_term(
     // operator
     // +a*X^b, -aX^b, X, +a, a
     // ^       ^      ^  ^   ^ current
-    if (Parser::expect(current, end, OperatorPlus) || Parser::expect(current, end, OperatorMinus)) {
-        (*current)->kind == OperatorPlus ? sign = 1 : sign = -1;
-
-        auto next = std::next(*current);
-        if (!Parser::expect(&next, end, Integer)
-        && !Parser::expect(&next, end, Decimal)
-        && !Parser::expect(&next, end, Char)) {
+    if (Parser::expect(tokens, *current, OperatorPlus)
+        || Parser::expect(tokens, *current, OperatorMinus)) {
+        tokens.kind(*current) == OperatorPlus ? sign = 1 : sign = -1;
+
+        std::size_t next = *current + 1;
+        if (!Parser::expect(tokens, next, Integer)
+        && !Parser::expect(tokens, next, Decimal)
+        && !Parser::expect(tokens, next, Char)) {
             return Result<s_term, Computor::Status>::err(Computor::Status::FAILURE);
         }
         *current = next;
@@ -359,20 +429,20 @@ Result<s_term, Computor::Status> Parser::parse_term(
     // coef
     // a*X^b, aX^b, X^b, aX, X, a
     // ^      ^     ^    ^   ^  ^ current
-    if (Parser::expect(current, end, Integer) || Parser::expect(current, end, Decimal)) {
+    if (Parser::expect(tokens, *current, Integer) || Parser::expect(tokens, *current, Decimal)) {
         // OK: aX^b, a*X^b, a
         // NG: aX^, a*X^, a*, aXX, ...
-        std::pair<Computor::Status, double> result = Parser::stod((*current)->word);
-        if (result.first == Computor::Status::FAILURE) {
+        double value = tokens.value(*current);
+        if (Computor::isnan(value)) {
             return Result<s_term, Computor::Status>::err(Computor::Status::FAILURE);
         }
 
-        auto next = std::next(*current);
-        if (Parser::consume(&next, end, OperatorMul) && !Parser::expect(&next, end, Char)) {
+        std::size_t next = *current + 1;
+        if (Parser::consume(tokens, &next, OperatorMul) && !Parser::expect(tokens, next, Char)) {
             return Result<s_term, Computor::Status>::err(Computor::Status::FAILURE);
         }
         *current = next;
-        coefficient = result.second;
+        coefficient = value;
     } else {
         // X^b, X
         coefficient = 1.0;
@@ -381,15 +451,17 @@ Result<s_term, Computor::Status> Parser::parse_term(
     // base
     // a*X^b, aX^b, X^b, aX, X, a
     //   ^     ^    ^     ^  ^   ^ current
-    if (Parser::expect(current, end, Char)) {
+    if (Parser::expect(tokens, *current, Char)) {
         // X^b, X
-        variable = (*current)->word[0];
+        variable = tokens.word(*current)[0];
         ++(*current);
 
-        if (Parser::consume(current, end, TermPowSymbol)) {
+        if (Parser::consume(tokens, current, TermPowSymbol)) {
             // X^b
-            if (Parser::expect(current, end, Integer)) {
-                std::pair<Computor::Status, std::int32_t> result = Parser::stoi((*current)->word);
+            if (Parser::expect(tokens, *current, Integer)) {
+                // power = integer; 0 <= power <= INT32_MAX
+                std::pair<Computor::Status, std::int32_t> result;
+                result = Computor::stoi(tokens.word(*current));
                 if (result.first == Computor::Status::FAILURE) {
                     return Result<s_term, Computor::Status>::err(Computor::Status::FAILURE);
                 }
@@ -418,16 +490,211 @@ Result<s_term, Computor::Status> Parser::parse_term(
 ////////////////////////////////////////////////////////////////////////////////
 
 
+// Tokenizer::lex()と同じ規則で次のtokenを切り出す
+//   SP    : skip
+//   +-*=^ : operator
+//   word  : Char / Integer / Decimal / [Integer, Decimal][Char]. それ以外はNone
+void Parser::scan_next(s_scanner *scanner) noexcept(true) {
+    if (!scanner) { return; }
+
+    scanner->kind = None;
+    scanner->word = std::string_view();
+    if (scanner->pending_char != '\0') {
+        if constexpr (Stats::kEnabled) {
+            ++scanner->tokens;
+        }
+        scanner->kind = Char;
+        scanner->variable = scanner->pending_char;
+        scanner->pending_char = '\0';
+        return;
+    }
+
+    std::string_view source = scanner->source;
+    while (scanner->pos < source.length() && source[scanner->pos] == Computor::SP) {
+        ++scanner->pos;
+    }
+    if (source.length() <= scanner->pos) {
+        scanner->is_end = true;
+        return;
+    }
+    if constexpr (Stats::kEnabled) {
+        ++scanner->tokens;
+    }
+
+    char c = source[scanner->pos];
+    switch (c) {
+        case Computor::OP_PLUS:  scanner->kind = OperatorPlus; break;
+        case Computor::OP_MINUS: scanner->kind = OperatorMinus; break;
+        case Computor::OP_MUL:   scanner->kind = OperatorMul; break;
+        case Computor::OP_EQUAL: scanner->kind = OperatorEqual; break;
+        case Computor::OP_POW:   scanner->kind = TermPowSymbol; break;
+        default: break;
+    }
+    if (scanner->kind != None) {
+        ++scanner->pos;
+        return;
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(c))) {
+        if (!Parser::is_delimiter(*scanner, scanner->pos + 1)) {
+            return;
+        }
+        ++scanner->pos;
+        scanner->kind = Char;
+        scanner->variable = c;
+    } else if (std::isdigit(static_cast<unsigned char>(c))) {
+        Parser::scan_number(scanner);
+    }
+
+    // base charは全てのCharで一致すること (Tokenizer::validate_token_stream()と同じ)
+    char variable = scanner->kind == Char ? scanner->variable : scanner->pending_char;
+    if (variable != '\0') {
+        if (scanner->base_char == '\0') {
+            scanner->base_char = variable;
+        } else if (scanner->base_char != variable) {
+            scanner->kind = None;
+        }
+    }
+}
+
+// integer / decimal, 直後のALPHA 1文字は次のtoken (Char) とする
+void Parser::scan_number(s_scanner *scanner) noexcept(true) {
+    std::string_view source = scanner->source;
+    std::size_t begin = scanner->pos;
+    std::size_t pos = begin;
+    TokenKind kind = Integer;
+
+    while (pos < source.length() && std::isdigit(static_cast<unsigned char>(source[pos]))) {
+        ++pos;
+    }
+    if (pos < source.length() && source[pos] == '.') {
+        std::size_t frac_begin = ++pos;
+        while (pos < source.length() && std::isdigit(static_cast<unsigned char>(source[pos]))) {
+            ++pos;
+        }
+        if (pos == frac_begin) { return; }
+        kind = Decimal;
+    }
+
+    char alpha = '\0';
+    if (pos < source.length() && std::isalpha(static_cast<unsigned char>(source[pos]))) {
+        alpha = source[pos];
+        ++pos;
+    }
+    if (!Parser::is_delimiter(*scanner, pos)) {
+        return;
+    }
+
+    std::string_view word = source.substr(begin, pos - begin - (alpha != '\0'));
+    std::pair<Computor::Status, double> result = Computor::stod(word);
+    if (result.first == Computor::Status::FAILURE) {
+        return;
+    }
+    scanner->pos = pos;
+    scanner->kind = kind;
+    scanner->word = word;
+    scanner->value = result.second;
+    scanner->pending_char = alpha;
+}
+
+// 入力の終端もdelimiterとする
+bool Parser::is_delimiter(const s_scanner &scanner, std::size_t pos) noexcept(true) {
+    if (scanner.source.length() <= pos) {
+        return true;
+    }
+    switch (scanner.source[pos]) {
+        case Computor::SP:
+        case Computor::OP_PLUS:
+        case Computor::OP_MINUS:
+        case Computor::OP_MUL:
+        case Computor::OP_EQUAL:
+        case Computor::OP_POW:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Parser::is_expression_begin(const s_scanner &scanner) noexcept(true) {
+    return scanner.kind == Char
+        || scanner.kind == Integer
+        || scanner.kind == Decimal
+        || scanner.kind == OperatorPlus
+        || scanner.kind == OperatorMinus;
+}
+
+// parse_term()のscanner版
+// term = ( operator ) [ coefficient ("*") ] ALPHA "^" 1*( DIGIT )
+Computor::Status Parser::recognize_term(s_scanner *scanner, s_term *term) noexcept(true) {
+    if (!scanner || !term) { return Computor::Status::FAILURE; }
+
+    double coefficient = 1.0;
+    char variable = '\0';
+    std::int32_t degree = 0;
+    std::int32_t sign = 1;
+
+    // operator
+    if (scanner->kind == OperatorPlus || scanner->kind == OperatorMinus) {
+        sign = scanner->kind == OperatorPlus ? 1 : -1;
+        Parser::scan_next(scanner);
+        if (scanner->kind != Integer && scanner->kind != Decimal && scanner->kind != Char) {
+            return Computor::Status::FAILURE;
+        }
+    }
+
+    // coef
+    if (scanner->kind == Integer || scanner->kind == Decimal) {
+        coefficient = scanner->value;
+        Parser::scan_next(scanner);
+        if (scanner->kind == OperatorMul) {
+            Parser::scan_next(scanner);
+            if (scanner->kind != Char) {
+                return Computor::Status::FAILURE;
+            }
+        }
+    }
+
+    // base
+    if (scanner->kind == Char) {
+        variable = scanner->variable;
+        degree = 1;
+        Parser::scan_next(scanner);
+        if (scanner->kind == TermPowSymbol) {
+            Parser::scan_next(scanner);
+            if (scanner->kind != Integer) {
+                return Computor::Status::FAILURE;
+            }
+            std::pair<Computor::Status, std::int32_t> result = Computor::stoi(scanner->word);
+            if (result.first == Computor::Status::FAILURE) {
+                return Computor::Status::FAILURE;
+            }
+            degree = result.second;
+            Parser::scan_next(scanner);
+        }
+    }
+
+    term->coefficient = coefficient * sign;
+    term->variable = variable;
+    term->degree = degree;
+    return Computor::Status::SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 // 0 = 0は表示, 0 * X + 1 = 0は非表示
 // ^           ^^^^^
-std::string Parser::reduced_form(const Polynomials &polynomial) const noexcept(true) {
-    std::ostringstream reduced_form;
+// "4 * X^2 - 3 * X + 1 = 0" をoutに追加する
+void Parser::append_reduced_form(
+        const Polynomials &polynomial,
+        OutputBuffer *out) const noexcept(true) {
     bool is_first_term = true;
 
     for (auto itr = polynomial.crbegin(); itr != polynomial.crend(); ++itr) {
         std::int32_t pow = itr->first;
         double coef = itr->second;
-        std::string sign = "";
+        std::string_view sign = "";
 
         if (coef == 0.0) { continue; }
         if (coef < 0) {
@@ -436,21 +703,25 @@ std::string Parser::reduced_form(const Polynomials &polynomial) const noexcept(t
             sign = "+ ";
         }
 
-        reduced_form << sign << Computor::abs(coef);
+        out->append(sign);
+        out->append(Computor::abs(coef));
         if (pow == 1) {
-            reduced_form << " * " << this->variable_;
+            out->append(" * ");
+            out->append(this->variable_);
         } else if (1 < pow) {
-            reduced_form << " * " << this->variable_ << "^" << pow;
+            out->append(" * ");
+            out->append(this->variable_);
+            out->append('^');
+            out->append(pow);
         }
-        reduced_form << " ";
+        out->append(' ');
 
         if (is_first_term) { is_first_term = false; }
     }
-    if (reduced_form.str().empty()) {
-        reduced_form << "0 ";
+    if (is_first_term) {
+        out->append("0 ");
     }
-    reduced_form << "= 0";
-    return reduced_form.str();
+    out->append("= 0");
 }
 
 
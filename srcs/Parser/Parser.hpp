@@ -1,10 +1,15 @@
 #pragma once
 
 # include <deque>
-# include <map>
+# include <iostream>
+# include <memory_resource>
 # include <string>
+# include <string_view>
 # include <utility>
 # include "computor.hpp"
+# include "OutputBuffer.hpp"
+# include "Polynomial.hpp"
+# include "Stats.hpp"
 # include "Tokenizer.hpp"
 
 struct s_term {
@@ -13,18 +18,53 @@ struct s_term {
     std::int32_t degree;
 };
 
+// recognize_equation()の字句解析の状態. 現在のtokenのみを保持する
+struct s_scanner {
+    std::string_view source;
+    std::size_t pos;
+    TokenKind kind;       // 現在のtoken. 不正なtokenはNone
+    bool is_end;
+    std::string_view word;
+    double value;         // Integer, Decimal
+    char variable;        // Char
+    char base_char;       // 最初のChar. 以降のCharと一致すること
+    char pending_char;    // [coef][base]の[base]. "2X"など
+    std::uint64_t tokens; // 読んだtoken数 (Stats::kEnabledの場合のみ数える)
+};
 
-using Polynomials = std::map<std::int32_t, double>;
-using TokenItr = Tokens::const_iterator;
 
+// resourceを渡した場合、polynomial_のsparseな項とparse中の一時的なdataをresourceから確保する
+// resourceがarenaの場合、arenaのrelease()の前にreset()すること
 class Parser {
  public:
     Parser();
+    explicit Parser(std::pmr::memory_resource *resource);
     ~Parser();
 
+    Result<Polynomials, ErrMsg> parse_equation(const TokenStream &tokens) noexcept(true);
     Result<Polynomials, ErrMsg> parse_equation(const Tokens &tokens) noexcept(true);
-    void display_reduced_form() const noexcept(true);
-    void display_polynomial_degree() const noexcept(true);
+
+    // parse_equation()をtoken列の分割ごとに行う
+    //   begin_equation() -> parse_tokens() * n -> end_equation()
+    void begin_equation() noexcept(true);
+    Result<Computor::Status, ErrMsg> parse_tokens(const TokenStream &tokens) noexcept(true);
+    Result<Polynomials, ErrMsg> end_equation() noexcept(true);
+
+    // tokenを保持せず、入力の文字から直接parseする
+    // FAILUREの場合、errorの詳細はtokenize, parse_equation()で求める
+    Computor::Status recognize_equation(std::string_view equation) noexcept(true);
+
+    void reset() noexcept(true);
+
+    // statsにReduceの時間を記録する (nullptrなら記録しない. 所有しない)
+    // counts()は最後にparseした方程式の計数 (Stats::kEnabledでなければ全て0)
+    void set_stats(Stats *stats) noexcept(true);
+    const s_parse_counts &counts() const noexcept(true);
+
+    void display_reduced_form(std::ostream &out = std::cout) const noexcept(true);
+    void display_polynomial_degree(std::ostream &out = std::cout) const noexcept(true);
+    void format_reduced_form(OutputBuffer *out) const noexcept(true);
+    void format_polynomial_degree(OutputBuffer *out) const noexcept(true);
 
     const Polynomials &polynomial() const noexcept(true);
     std::string reduced_form() const noexcept(true);
@@ -33,17 +73,21 @@ class Parser {
 
  private:
     std::int32_t max_degree_ = 2;
+    std::pmr::memory_resource *memory_resource_;    // 所有しない
     Polynomials polynomial_;
     char variable_;
 
-    void parse_expression(
-            TokenItr *itr,
-            const TokenItr &end,
-            bool is_lhs) noexcept(true);
+    // parse_tokens()の状態
+    bool is_lhs_;
+    std::size_t term_count_;  // parse中のexpressionの項数
+    ErrMsg error_;            // 最初のerror. 空ならerrorなし
+    Stats *stats_;
+    s_parse_counts counts_;
+
     void reduce() noexcept(true);
     void drop_zero_term() noexcept(true);
     void adjust_sign() noexcept(true);
-    std::string reduced_form(const Polynomials &polynomial) const noexcept(true);
+    void append_reduced_form(const Polynomials &polynomial, OutputBuffer *out) const noexcept(true);
     void display_polynomial() const noexcept(true);
 
     bool is_valid_degree(std::int32_t degree) const noexcept(true);
@@ -51,27 +95,36 @@ class Parser {
     bool is_valid_variable(char var, std::int32_t degree) const noexcept(true);
 
     static Result<s_term, Computor::Status> parse_term(
-            TokenItr *current,
-            const TokenItr &end) noexcept(true);
+            const TokenStream &tokens,
+            std::size_t *current) noexcept(true);
 
     Computor::Status set_valid_term(const s_term &term, bool is_lhs) noexcept(true);
     Result<Computor::Status, ErrMsg> validate() noexcept(true);
 
-    static std::pair<Computor::Status, double> stod(const std::string &word) noexcept(true);
-    static std::pair<Computor::Status, std::int32_t> stoi(const std::string &word) noexcept(true);
+    // recognize_equation
+    static void scan_next(s_scanner *scanner) noexcept(true);
+    static void scan_number(s_scanner *scanner) noexcept(true);
+    static bool is_delimiter(const s_scanner &scanner, std::size_t pos) noexcept(true);
+    static bool is_expression_begin(const s_scanner &scanner) noexcept(true);
+    Computor::Status recognize_terms(s_scanner *scanner) noexcept(true);
+    static Computor::Status recognize_term(s_scanner *scanner, s_term *term) noexcept(true);
+
+    static bool is_expression_begin(
+            const TokenStream &tokens,
+            std::size_t current) noexcept(true);
 
     static bool is_at_end(
-            TokenItr *current,
-            const TokenItr &end) noexcept(true);
+            const TokenStream &tokens,
+            std::size_t current) noexcept(true);
 
     static bool consume(
-            TokenItr *current,
-            const TokenItr &end,
+            const TokenStream &tokens,
+            std::size_t *current,
             TokenKind expected_kind) noexcept(true);
 
     static bool expect(
-            TokenItr *current,
-            const TokenItr &end,
+            const TokenStream &tokens,
+            std::size_t current,
             TokenKind expected_kind) noexcept(true);
 
     static void skip_sp(
@@ -80,8 +133,8 @@ class Parser {
             std::size_t *end_pos) noexcept(true);
 
     static std::string error_message(
-            TokenItr *current,
-            const TokenItr &end) noexcept(true);
+            const TokenStream &tokens,
+            std::size_t current) noexcept(true);
 
     // copy invalid
     Parser &operator=(const Parser &rhs);
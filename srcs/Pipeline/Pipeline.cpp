@@ -0,0 +1,253 @@
+#include "Pipeline.hpp"
+#include <cstdlib>
+#include <exception>
+#include "Calculator.hpp"
+#include "Result.hpp"
+
+Pipeline::Pipeline()
+    : arena_(),
+      tokenizer_(),
+      parser_(&this->arena_),
+      calculator_(&this->arena_),
+      solution_(),
+      solution_cache_(nullptr),
+      cache_key_(),
+      stats_(nullptr),
+      format_(Computor::TEXT),
+      out_(),
+      err_() {}
+
+Pipeline::~Pipeline() {}
+
+// 結果はbufferに貯め、out, errそれぞれ1回で書き込む
+int Pipeline::run(
+        std::string_view equation,
+        std::ostream &out,
+        std::ostream &err) noexcept(true) {
+    int result = Pipeline::run(equation, &this->out_, &this->err_);
+    this->out_.write_to(out);
+    if (!this->err_.empty()) {
+        this->err_.write_to(err);
+    }
+    return result;
+}
+
+// 方程式の後、arena_から確保したParserの多項式を解放してからarena_をrelease()する
+int Pipeline::run(
+        std::string_view equation,
+        OutputBuffer *out,
+        OutputBuffer *err) noexcept(true) {
+    int result = Pipeline::run_equation(equation, out, err);
+    this->parser_.reset();
+    this->arena_.release();
+    return result;
+}
+
+void Pipeline::set_solution_cache(SolutionCache *cache) noexcept(true) {
+    this->solution_cache_ = cache;
+}
+
+void Pipeline::set_stats(Stats *stats) noexcept(true) {
+    this->stats_ = stats;
+    this->parser_.set_stats(stats);
+}
+
+void Pipeline::set_format(Computor::OutputFormat format) noexcept(true) {
+    this->format_ = format;
+}
+
+void Pipeline::set_root_finder_config(const s_root_finder_config &config) noexcept(true) {
+    this->calculator_.set_root_finder_config(config);
+}
+
+const s_arena_counts &Pipeline::arena_counts() const noexcept(true) {
+    return this->arena_.counts();
+}
+
+// 入力の文字から直接parseし、失敗した場合のみtokenize -> parseでerrorを求める
+// statsを設定した場合、各stageの時間とparseの計数を記録する
+int Pipeline::run_equation(
+        std::string_view equation,
+        OutputBuffer *out,
+        OutputBuffer *err) noexcept(true) {
+    Stats::Timer total_timer(this->stats_, Stats::Total);
+    Computor::Status status;
+    this->parser_.reset();
+    {
+        Stats::Timer timer(this->stats_, Stats::Recognize);
+        status = this->parser_.recognize_equation(equation);
+    }
+    if (status == Computor::Status::SUCCESS) {
+        Pipeline::record_counts();
+        return Pipeline::solve_polynomial(equation, this->parser_.polynomial(), out);
+    }
+
+    Result<Computor::Status, ErrMsg> lex_result;
+    {
+        Stats::Timer timer(this->stats_, Stats::Tokenize);
+        lex_result = this->tokenizer_.lex(equation);
+    }
+    if (lex_result.is_err()) {
+        return Pipeline::report_error(equation, lex_result.err_value(), out, err);
+    }
+
+    this->parser_.reset();
+    Result<Polynomials, ErrMsg> parse_result;
+    {
+        Stats::Timer timer(this->stats_, Stats::Parse);
+        parse_result = this->parser_.parse_equation(this->tokenizer_.token_stream());
+    }
+    Pipeline::record_counts();
+    if (parse_result.is_err()) {
+        return Pipeline::report_error(equation, parse_result.err_value(), out, err);
+    }
+    return Pipeline::solve_polynomial(equation, parse_result.ok_value(), out);
+}
+
+int Pipeline::solve(
+        const Parser &parser,
+        const Polynomials &polynomial,
+        OutputBuffer *out,
+        SolutionCache *cache) noexcept(true) {
+    Calculator calculator;
+    s_cached_solution solution;
+    SolutionCache::Key key;
+    Pipeline::find_solution(polynomial, cache, &key, &calculator, &solution);
+    return Pipeline::format_text(parser, solution, out);
+}
+
+// 戻り値は解が1つ以上あればEXIT_SUCCESS (solve()と同じ)
+int Pipeline::solve_record(
+        std::string_view equation,
+        const Polynomials &polynomial,
+        Computor::OutputFormat format,
+        OutputBuffer *out,
+        SolutionCache *cache) noexcept(true) {
+    Calculator calculator;
+    s_cached_solution solution;
+    SolutionCache::Key key;
+    Pipeline::find_solution(polynomial, cache, &key, &calculator, &solution);
+    return Pipeline::format_record(equation, polynomial, format, solution, out);
+}
+
+int Pipeline::error_record(
+        std::string_view equation,
+        std::string_view error,
+        Computor::OutputFormat format,
+        OutputBuffer *out) noexcept(true) {
+    s_equation_record record = {
+            .equation = equation,
+            .status = EXIT_FAILURE,
+            .polynomial = nullptr,
+            .type = QuadraticSolver::NoSolutionCalculationError,
+            .solutions = nullptr,
+            .error = error
+    };
+    RecordFormatter::append(record, format, out);
+    return EXIT_FAILURE;
+}
+
+int Pipeline::report_error(
+        std::string_view equation,
+        std::string_view error,
+        OutputBuffer *out,
+        OutputBuffer *err) const noexcept(true) {
+    if (this->format_ != Computor::TEXT) {
+        return Pipeline::error_record(equation, error, this->format_, out);
+    }
+    err->append("[Error] ");
+    err->append(error);
+    err->append('\n');
+    return EXIT_FAILURE;
+}
+
+int Pipeline::solve_polynomial(
+        std::string_view equation,
+        const Polynomials &polynomial,
+        OutputBuffer *out) noexcept(true) {
+    {
+        Stats::Timer timer(this->stats_, Stats::Solve);
+        Pipeline::find_solution(polynomial, this->solution_cache_, &this->cache_key_,
+                                &this->calculator_, &this->solution_);
+    }
+
+    Stats::Timer timer(this->stats_, Stats::Format);
+    if (this->format_ != Computor::TEXT) {
+        return Pipeline::format_record(equation, polynomial, this->format_, this->solution_, out);
+    }
+    return Pipeline::format_text(this->parser_, this->solution_, out);
+}
+
+void Pipeline::record_counts() noexcept(true) {
+    if constexpr (Stats::kEnabled) {
+        if (this->stats_ != nullptr) {
+            this->stats_->count(this->parser_.counts());
+        }
+    }
+}
+
+// cacheにあればその解、なければcalculatorで解いてcacheに入れる (cache == nullptrなら解くだけ)
+// key, solution->solutionsはcapacityを再利用して上書きする
+// cacheの確保に失敗した場合はcacheなしで解き、解の複製に失敗した場合は計算エラーとする
+void Pipeline::find_solution(
+        const Polynomials &polynomial,
+        SolutionCache *cache,
+        SolutionCache::Key *key,
+        Calculator *calculator,
+        s_cached_solution *solution) noexcept(true) {
+    try {
+        if (cache != nullptr) {
+            SolutionCache::make_key(polynomial, key);
+            if (cache->find_by_key(*key, solution)) {
+                return;
+            }
+        }
+    } catch (const std::exception &e) {
+        cache = nullptr;
+    }
+
+    solution->type = calculator->solve_equation(polynomial);
+    try {
+        solution->solutions = calculator->solutions();
+    } catch (const std::exception &e) {
+        solution->type = QuadraticSolver::NoSolutionCalculationError;
+        solution->solutions.clear();
+        return;
+    }
+    if (cache == nullptr) {
+        return;
+    }
+    try {
+        cache->insert_by_key(*key, *solution);
+    } catch (const std::exception &e) {
+        // cacheに入らないだけで、解はそのまま使える
+    }
+}
+
+int Pipeline::format_text(
+        const Parser &parser,
+        const s_cached_solution &solution,
+        OutputBuffer *out) noexcept(true) {
+    parser.format_reduced_form(out);
+    parser.format_polynomial_degree(out);
+    return Calculator::format_result(solution.type, solution.solutions, out);
+}
+
+int Pipeline::format_record(
+        std::string_view equation,
+        const Polynomials &polynomial,
+        Computor::OutputFormat format,
+        const s_cached_solution &solution,
+        OutputBuffer *out) noexcept(true) {
+    int status = solution.solutions.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+    s_equation_record record = {
+            .equation = equation,
+            .status = status,
+            .polynomial = &polynomial,
+            .type = solution.type,
+            .solutions = &solution.solutions,
+            .error = ""
+    };
+    RecordFormatter::append(record, format, out);
+    return status;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+# include <iostream>
+# include <string_view>
+# include "Arena.hpp"
+# include "Calculator.hpp"
+# include "computor.hpp"
+# include "OutputBuffer.hpp"
+# include "Parser.hpp"
+# include "Polynomial.hpp"
+# include "RecordFormatter.hpp"
+# include "SolutionCache.hpp"
+# include "Stats.hpp"
+# include "Tokenizer.hpp"
+
+// 1つの方程式を parse -> 表示 -> 求解 する
+// Tokenizer, Parser, Calculator, 解のbufferは方程式ごとにreset()して再利用し、capacityを保持する
+// (2回目以降次数が増えない限りheapを確保しない. cacheにない方程式はcacheへの追加のみ確保する)
+// Parser, Calculatorの方程式1つの間だけの一時的なdataはarena_から確保し、方程式毎にrelease()する
+// SolutionCacheを設定した場合、簡約後の多項式が同じ方程式は解かずにcacheの解を表示する
+// Statsを設定した場合、stage (Stats::Stage) 毎の時間とparseの計数を記録する
+// formatがJSON, BINARYの場合、errorも含めて1方程式1recordをoutに書く (errには書かない)
+class Pipeline {
+ public:
+    Pipeline();
+    ~Pipeline();
+
+    // 戻り値はcalc_equation()と同じ (EXIT_SUCCESS / EXIT_FAILURE)
+    // OutputBuffer版はout, errに追加するだけで書き込まない (outとerrは同じbufferでもよい)
+    int run(std::string_view equation, std::ostream &out, std::ostream &err) noexcept(true);
+    int run(std::string_view equation, OutputBuffer *out, OutputBuffer *err) noexcept(true);
+    void set_solution_cache(SolutionCache *cache) noexcept(true);
+    void set_stats(Stats *stats) noexcept(true);
+    void set_format(Computor::OutputFormat format) noexcept(true);
+    void set_root_finder_config(const s_root_finder_config &config) noexcept(true);
+    const s_arena_counts &arena_counts() const noexcept(true);
+
+    static int solve(
+            const Parser &parser,
+            const Polynomials &polynomial,
+            OutputBuffer *out,
+            SolutionCache *cache = nullptr) noexcept(true);
+    static int solve_record(
+            std::string_view equation,
+            const Polynomials &polynomial,
+            Computor::OutputFormat format,
+            OutputBuffer *out,
+            SolutionCache *cache = nullptr) noexcept(true);
+    static int error_record(
+            std::string_view equation,
+            std::string_view error,
+            Computor::OutputFormat format,
+            OutputBuffer *out) noexcept(true);
+
+ private:
+    Arena arena_;
+    Tokenizer tokenizer_;
+    Parser parser_;                     // arena_から確保する
+    Calculator calculator_;             // arena_から確保する
+    s_cached_solution solution_;        // 最後に解いた方程式の解
+    SolutionCache *solution_cache_;     // 所有しない. nullptrならcacheしない
+    SolutionCache::Key cache_key_;      // solution_cache_のkey. 方程式ごとに上書きする
+    Stats *stats_;                      // 所有しない. nullptrなら記録しない
+    Computor::OutputFormat format_;
+    OutputBuffer out_;                  // ostream版のrun()用
+    OutputBuffer err_;
+
+    int run_equation(
+            std::string_view equation,
+            OutputBuffer *out,
+            OutputBuffer *err) noexcept(true);
+    int report_error(
+            std::string_view equation,
+            std::string_view error,
+            OutputBuffer *out,
+            OutputBuffer *err) const noexcept(true);
+    int solve_polynomial(
+            std::string_view equation,
+            const Polynomials &polynomial,
+            OutputBuffer *out) noexcept(true);
+    void record_counts() noexcept(true);
+    static void find_solution(
+            const Polynomials &polynomial,
+            SolutionCache *cache,
+            SolutionCache::Key *key,
+            Calculator *calculator,
+            s_cached_solution *solution) noexcept(true);
+    static int format_text(
+            const Parser &parser,
+            const s_cached_solution &solution,
+            OutputBuffer *out) noexcept(true);
+    static int format_record(
+            std::string_view equation,
+            const Polynomials &polynomial,
+            Computor::OutputFormat format,
+            const s_cached_solution &solution,
+            OutputBuffer *out) noexcept(true);
+
+    // copy invalid
+    Pipeline &operator=(const Pipeline &rhs);
+    Pipeline(const Pipeline &other);
+};
@@ -0,0 +1,202 @@
+#include "Polynomial.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+Polynomial::Polynomial()
+    : dense_(Polynomial::init_dense(std::make_index_sequence<kDenseSize>())),
+      dense_mask_(0),
+      sparse_() {}
+
+Polynomial::Polynomial(std::pmr::memory_resource *resource)
+    : dense_(Polynomial::init_dense(std::make_index_sequence<kDenseSize>())),
+      dense_mask_(0),
+      sparse_(resource) {}
+
+Polynomial::Polynomial(std::initializer_list<std::pair<std::int32_t, double>> terms)
+    : Polynomial() {
+    for (const auto &term : terms) {
+        (*this)[term.first] = term.second;
+    }
+}
+
+Polynomial::Polynomial(const Polynomial &other)
+    : dense_(other.dense_),
+      dense_mask_(other.dense_mask_),
+      sparse_(other.sparse_) {}
+
+Polynomial::Polynomial(Polynomial &&other) noexcept(false)
+    : dense_(other.dense_),
+      dense_mask_(other.dense_mask_),
+      sparse_(std::move(other.sparse_), std::pmr::get_default_resource()) {}
+
+Polynomial::~Polynomial() {}
+
+Polynomial &Polynomial::operator=(const Polynomial &rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    Polynomial::copy_dense(rhs);
+    this->sparse_ = rhs.sparse_;
+    return *this;
+}
+
+Polynomial &Polynomial::operator=(Polynomial &&rhs) noexcept(false) {
+    if (this == &rhs) {
+        return *this;
+    }
+    Polynomial::copy_dense(rhs);
+    this->sparse_ = std::move(rhs.sparse_);
+    return *this;
+}
+
+// std::map::operator[]と同じく、存在しないdegreeは0.0で追加する
+double &Polynomial::operator[](std::int32_t degree) noexcept(false) {
+    if (!Polynomial::is_dense(degree)) {
+        return this->sparse_[degree];
+    }
+    std::uint32_t bit = std::uint32_t(1) << degree;
+    if (!(this->dense_mask_ & bit)) {
+        this->dense_mask_ |= bit;
+        this->dense_[degree].second = 0.0;
+    }
+    return this->dense_[degree].second;
+}
+
+const double &Polynomial::at(std::int32_t degree) const noexcept(false) {
+    if (!Polynomial::is_dense(degree)) {
+        return this->sparse_.at(degree);
+    }
+    if (!(this->dense_mask_ & (std::uint32_t(1) << degree))) {
+        throw std::out_of_range("Polynomial::at");
+    }
+    return this->dense_[degree].second;
+}
+
+Polynomial::iterator Polynomial::find(std::int32_t degree) noexcept(true) {
+    if (!Polynomial::is_dense(degree)) {
+        Sparse::iterator itr = this->sparse_.find(degree);
+        if (itr == this->sparse_.end()) {
+            return Polynomial::end();
+        }
+        return iterator(this, kDenseSize, itr);
+    }
+    if (!(this->dense_mask_ & (std::uint32_t(1) << degree))) {
+        return Polynomial::end();
+    }
+    return iterator(this, degree, this->sparse_.end());
+}
+
+Polynomial::const_iterator Polynomial::find(std::int32_t degree) const noexcept(true) {
+    return const_cast<Polynomial *>(this)->find(degree);
+}
+
+Polynomial::iterator Polynomial::erase(iterator pos) noexcept(true) {
+    iterator next = pos;
+    ++next;
+    if (pos.index_ < kDenseSize) {
+        this->dense_mask_ &= ~(std::uint32_t(1) << pos.index_);
+    } else {
+        this->sparse_.erase(pos.sparse_itr_);
+    }
+    return next;
+}
+
+void Polynomial::clear() noexcept(true) {
+    this->dense_mask_ = 0;
+    this->sparse_.clear();
+}
+
+Polynomial::size_type Polynomial::size() const noexcept(true) {
+    return std::popcount(this->dense_mask_) + this->sparse_.size();
+}
+
+bool Polynomial::empty() const noexcept(true) {
+    return this->dense_mask_ == 0 && this->sparse_.empty();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Polynomial::iterator Polynomial::begin() noexcept(true) {
+    Sparse::iterator split = this->sparse_.lower_bound(0);
+    if (split != this->sparse_.begin() || this->dense_mask_ == 0) {
+        return iterator(this, kDenseSize, this->sparse_.begin());
+    }
+    return iterator(this, std::countr_zero(this->dense_mask_), this->sparse_.end());
+}
+
+Polynomial::iterator Polynomial::end() noexcept(true) {
+    return iterator(this, kDenseSize, this->sparse_.end());
+}
+
+Polynomial::const_iterator Polynomial::begin() const noexcept(true) {
+    return const_cast<Polynomial *>(this)->begin();
+}
+
+Polynomial::const_iterator Polynomial::end() const noexcept(true) {
+    return const_cast<Polynomial *>(this)->end();
+}
+
+Polynomial::const_iterator Polynomial::cbegin() const noexcept(true) {
+    return Polynomial::begin();
+}
+
+Polynomial::const_iterator Polynomial::cend() const noexcept(true) {
+    return Polynomial::end();
+}
+
+Polynomial::reverse_iterator Polynomial::rbegin() noexcept(true) {
+    return reverse_iterator(Polynomial::end());
+}
+
+Polynomial::reverse_iterator Polynomial::rend() noexcept(true) {
+    return reverse_iterator(Polynomial::begin());
+}
+
+Polynomial::const_reverse_iterator Polynomial::rbegin() const noexcept(true) {
+    return const_reverse_iterator(Polynomial::end());
+}
+
+Polynomial::const_reverse_iterator Polynomial::rend() const noexcept(true) {
+    return const_reverse_iterator(Polynomial::begin());
+}
+
+Polynomial::const_reverse_iterator Polynomial::crbegin() const noexcept(true) {
+    return Polynomial::rbegin();
+}
+
+Polynomial::const_reverse_iterator Polynomial::crend() const noexcept(true) {
+    return Polynomial::rend();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+bool Polynomial::operator==(const Polynomial &rhs) const noexcept(true) {
+    return Polynomial::size() == rhs.size()
+        && std::equal(Polynomial::begin(), Polynomial::end(), rhs.begin());
+}
+
+Polynomial::operator std::map<std::int32_t, double>() const {
+    std::map<std::int32_t, double> polynomial;
+
+    for (const auto &term : *this) {
+        polynomial.emplace_hint(polynomial.end(), term.first, term.second);
+    }
+    return polynomial;
+}
+
+bool Polynomial::is_dense(std::int32_t degree) noexcept(true) {
+    return 0 <= degree && degree < kDenseSize;
+}
+
+// degreeは固定のため、存在するmaskと係数のみコピーする
+void Polynomial::copy_dense(const Polynomial &other) noexcept(true) {
+    this->dense_mask_ = other.dense_mask_;
+    for (std::int32_t degree = 0; degree < kDenseSize; ++degree) {
+        this->dense_[degree].second = other.dense_[degree].second;
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+# include <array>
+# include <cstddef>
+# include <cstdint>
+# include <initializer_list>
+# include <iterator>
+# include <map>
+# include <memory_resource>
+# include <type_traits>
+# include <utility>
+
+// degree -> coefficient. std::mapと同じくdegreeの昇順に走査する
+// 0 <= degree < kDenseSize はarrayに直接格納し (dense)、それ以外のみstd::mapに格納する (sparse)
+//   dense_ : [0][1][2]...[15]   dense_mask_のbit iが立っている項のみ存在
+//   sparse_: {-1: ..., 16: ..., 100: ...}
+// sparse_のnodeはresource (既定はstd::pmr::get_default_resource()) から確保する
+// コピー, moveはresourceを引き継がない (既定のresourceを使う) ため、arenaの多項式も持ち出せる
+// resourceが異なる場合のmoveはsparse_のnodeを確保し直すため、例外を投げうる
+class Polynomial {
+ public:
+    using key_type = std::int32_t;
+    using mapped_type = double;
+    using value_type = std::pair<const std::int32_t, double>;
+    using size_type = std::size_t;
+
+    template <bool IsConst>
+    class Iterator;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr std::int32_t kDenseSize = 16;
+
+    Polynomial();
+    explicit Polynomial(std::pmr::memory_resource *resource);
+    Polynomial(std::initializer_list<std::pair<std::int32_t, double>> terms);
+    Polynomial(const Polynomial &other);
+    Polynomial(Polynomial &&other) noexcept(false);
+    ~Polynomial();
+
+    Polynomial &operator=(const Polynomial &rhs);
+    Polynomial &operator=(Polynomial &&rhs) noexcept(false);
+
+    double &operator[](std::int32_t degree) noexcept(false);
+    const double &at(std::int32_t degree) const noexcept(false);
+    iterator find(std::int32_t degree) noexcept(true);
+    const_iterator find(std::int32_t degree) const noexcept(true);
+    iterator erase(iterator pos) noexcept(true);
+    void clear() noexcept(true);
+
+    size_type size() const noexcept(true);
+    bool empty() const noexcept(true);
+
+    iterator begin() noexcept(true);
+    iterator end() noexcept(true);
+    const_iterator begin() const noexcept(true);
+    const_iterator end() const noexcept(true);
+    const_iterator cbegin() const noexcept(true);
+    const_iterator cend() const noexcept(true);
+    reverse_iterator rbegin() noexcept(true);
+    reverse_iterator rend() noexcept(true);
+    const_reverse_iterator rbegin() const noexcept(true);
+    const_reverse_iterator rend() const noexcept(true);
+    const_reverse_iterator crbegin() const noexcept(true);
+    const_reverse_iterator crend() const noexcept(true);
+
+    bool operator==(const Polynomial &rhs) const noexcept(true);
+    operator std::map<std::int32_t, double>() const;
+
+ private:
+    using Dense = std::array<value_type, kDenseSize>;
+    using Sparse = std::pmr::map<std::int32_t, double>;
+
+    Dense dense_;
+    std::uint32_t dense_mask_;
+    Sparse sparse_;
+
+    static bool is_dense(std::int32_t degree) noexcept(true);
+    template <std::size_t... Degree>
+    static Dense init_dense(std::index_sequence<Degree...>) noexcept(true);
+    void copy_dense(const Polynomial &other) noexcept(true);
+};
+
+
+// dense_の項 (index < kDenseSize) またはsparse_の項 (index == kSparse) を指す
+// sparse_の負のdegree -> dense_ -> sparse_の正のdegree の順に走査する
+template <bool IsConst>
+class Polynomial::Iterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Polynomial::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+
+    Iterator();
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Iterator(const Iterator<OtherConst> &other);  // NOLINT(runtime/explicit)
+
+    reference operator*() const noexcept(true);
+    pointer operator->() const noexcept(true);
+    Iterator &operator++() noexcept(true);
+    Iterator operator++(int) noexcept(true);
+    Iterator &operator--() noexcept(true);
+    Iterator operator--(int) noexcept(true);
+    bool operator==(const Iterator &rhs) const noexcept(true);
+    bool operator!=(const Iterator &rhs) const noexcept(true);
+
+    friend class Polynomial;
+    friend class Iterator<!IsConst>;
+
+ private:
+    using Owner = std::conditional_t<IsConst, const Polynomial, Polynomial>;
+    using SparseIterator = std::conditional_t<
+            IsConst, Polynomial::Sparse::const_iterator, Polynomial::Sparse::iterator>;
+
+    static constexpr std::int32_t kSparse = Polynomial::kDenseSize;
+
+    Owner *owner_;
+    std::int32_t index_;
+    SparseIterator sparse_itr_;
+
+    Iterator(Owner *owner, std::int32_t index, SparseIterator sparse_itr);
+
+    SparseIterator sparse_split() const noexcept(true);
+    std::int32_t next_dense(std::int32_t index) const noexcept(true);
+    std::int32_t prev_dense(std::int32_t index) const noexcept(true);
+};
+
+
+using Polynomials = Polynomial;
+
+#include "Polynomial.tpp"
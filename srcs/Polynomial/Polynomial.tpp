@@ -0,0 +1,156 @@
+#pragma once
+
+# include <bit>
+
+template <bool IsConst>
+Polynomial::Iterator<IsConst>::Iterator()
+    : owner_(nullptr),
+      index_(kSparse),
+      sparse_itr_() {}
+
+
+template <bool IsConst>
+template <bool OtherConst, typename>
+Polynomial::Iterator<IsConst>::Iterator(const Iterator<OtherConst> &other)
+    : owner_(other.owner_),
+      index_(other.index_),
+      sparse_itr_(other.sparse_itr_) {}
+
+
+template <bool IsConst>
+Polynomial::Iterator<IsConst>::Iterator(
+        Owner *owner,
+        std::int32_t index,
+        SparseIterator sparse_itr)
+    : owner_(owner),
+      index_(index),
+      sparse_itr_(sparse_itr) {}
+
+
+template <bool IsConst>
+typename Polynomial::Iterator<IsConst>::reference
+Polynomial::Iterator<IsConst>::operator*() const noexcept(true) {
+    if (index_ < kSparse) {
+        return owner_->dense_[index_];
+    }
+    return *sparse_itr_;
+}
+
+
+template <bool IsConst>
+typename Polynomial::Iterator<IsConst>::pointer
+Polynomial::Iterator<IsConst>::operator->() const noexcept(true) {
+    return &(**this);
+}
+
+
+// dense -> 次のdense, 無ければsparseの正のdegree
+// sparseの負のdegree -> 次のsparse, 正のdegreeに達したらdense
+template <bool IsConst>
+Polynomial::Iterator<IsConst> &Polynomial::Iterator<IsConst>::operator++() noexcept(true) {
+    if (index_ < kSparse) {
+        index_ = next_dense(index_ + 1);
+        if (index_ == kSparse) {
+            sparse_itr_ = sparse_split();
+        }
+        return *this;
+    }
+    ++sparse_itr_;
+    if (sparse_itr_ == sparse_split()) {
+        index_ = next_dense(0);
+    }
+    return *this;
+}
+
+
+template <bool IsConst>
+Polynomial::Iterator<IsConst> Polynomial::Iterator<IsConst>::operator++(int) noexcept(true) {
+    Iterator tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+
+template <bool IsConst>
+Polynomial::Iterator<IsConst> &Polynomial::Iterator<IsConst>::operator--() noexcept(true) {
+    if (index_ < kSparse) {
+        index_ = prev_dense(index_);
+        if (index_ == kSparse) {
+            sparse_itr_ = std::prev(sparse_split());
+        }
+        return *this;
+    }
+    if (sparse_itr_ == sparse_split()) {
+        index_ = prev_dense(kSparse);
+        if (index_ < kSparse) {
+            return *this;
+        }
+    }
+    --sparse_itr_;
+    return *this;
+}
+
+
+template <bool IsConst>
+Polynomial::Iterator<IsConst> Polynomial::Iterator<IsConst>::operator--(int) noexcept(true) {
+    Iterator tmp = *this;
+    --(*this);
+    return tmp;
+}
+
+
+template <bool IsConst>
+bool Polynomial::Iterator<IsConst>::operator==(const Iterator &rhs) const noexcept(true) {
+    if (index_ != rhs.index_) {
+        return false;
+    }
+    return index_ < kSparse || sparse_itr_ == rhs.sparse_itr_;
+}
+
+
+template <bool IsConst>
+bool Polynomial::Iterator<IsConst>::operator!=(const Iterator &rhs) const noexcept(true) {
+    return !(*this == rhs);
+}
+
+
+// sparse_の最初の正のdegree. 0 <= degree < kDenseSizeはsparse_に無いため、dense_の直後にあたる
+template <bool IsConst>
+typename Polynomial::Iterator<IsConst>::SparseIterator
+Polynomial::Iterator<IsConst>::sparse_split() const noexcept(true) {
+    return owner_->sparse_.lower_bound(0);
+}
+
+
+// index以降で最初に存在するdense_のindex. 無ければkSparse
+template <bool IsConst>
+std::int32_t Polynomial::Iterator<IsConst>::next_dense(std::int32_t index) const noexcept(true) {
+    if (kSparse <= index) {
+        return kSparse;
+    }
+    std::uint32_t mask = owner_->dense_mask_ >> index;
+    if (mask == 0) {
+        return kSparse;
+    }
+    return index + std::countr_zero(mask);
+}
+
+
+// indexより前で最後に存在するdense_のindex. 無ければkSparse
+template <bool IsConst>
+std::int32_t Polynomial::Iterator<IsConst>::prev_dense(std::int32_t index) const noexcept(true) {
+    if (index <= 0) {
+        return kSparse;
+    }
+    std::uint32_t mask = owner_->dense_mask_ & ((std::uint32_t(1) << index) - 1);
+    if (mask == 0) {
+        return kSparse;
+    }
+    return 31 - std::countl_zero(mask);
+}
+
+
+template <std::size_t... Degree>
+Polynomial::Dense Polynomial::init_dense(std::index_sequence<Degree...>) noexcept(true) {
+    return Dense{{value_type(static_cast<std::int32_t>(Degree), 0.0)...}};
+}
@@ -0,0 +1,192 @@
+#include "RecordFormatter.hpp"
+#include <bit>
+#include <charconv>
+#include <cmath>
+
+void RecordFormatter::append(
+        const s_equation_record &record,
+        Computor::OutputFormat format,
+        OutputBuffer *out) noexcept(true) {
+    if (format == Computor::BINARY) {
+        RecordFormatter::append_binary(record, out);
+    } else {
+        RecordFormatter::append_json(record, out);
+    }
+}
+
+void RecordFormatter::append_json(
+        const s_equation_record &record,
+        OutputBuffer *out) noexcept(true) {
+    out->append("{\"equation\":");
+    RecordFormatter::append_json_string(record.equation, out);
+    out->append(",\"status\":");
+    out->append(static_cast<std::int32_t>(record.status));
+
+    if (record.polynomial == nullptr) {
+        out->append(",\"error\":");
+        RecordFormatter::append_json_string(record.error, out);
+        out->append("}\n");
+        return;
+    }
+
+    out->append(",\"degree\":");
+    out->append(record.polynomial->crbegin()->first);
+    out->append(",\"terms\":[");
+    for (auto itr = record.polynomial->crbegin(); itr != record.polynomial->crend(); ++itr) {
+        if (itr != record.polynomial->crbegin()) {
+            out->append(',');
+        }
+        out->append("{\"degree\":");
+        out->append(itr->first);
+        out->append(",\"coefficient\":");
+        RecordFormatter::append_json_number(itr->second, out);
+        out->append('}');
+    }
+    out->append("],\"type\":");
+    RecordFormatter::append_json_string(RecordFormatter::solution_type_name(record.type), out);
+    out->append(",\"solutions\":[");
+    for (std::size_t i = 0; i < record.solutions->size(); ++i) {
+        const QuadraticSolver::Solution &solution = (*record.solutions)[i];
+        if (i != 0) {
+            out->append(',');
+        }
+        out->append("{\"re\":");
+        RecordFormatter::append_json_number(solution.re, out);
+        out->append(",\"im\":");
+        RecordFormatter::append_json_number(solution.im, out);
+        out->append('}');
+    }
+    out->append("]}\n");
+}
+
+void RecordFormatter::append_binary(
+        const s_equation_record &record,
+        OutputBuffer *out) noexcept(true) {
+    const bool is_error = (record.polynomial == nullptr);
+    const std::uint32_t term_count = is_error
+                                     ? 0 : static_cast<std::uint32_t>(record.polynomial->size());
+    const std::uint32_t solution_count = is_error
+                                         ? 0 : static_cast<std::uint32_t>(record.solutions->size());
+    const std::uint32_t equation_length = static_cast<std::uint32_t>(record.equation.size());
+    const std::uint32_t error_length = static_cast<std::uint32_t>(record.error.size());
+
+    std::uint32_t size = kBinaryHeaderSize + 16 * term_count + 16 * solution_count
+                         + equation_length + error_length;
+    std::uint32_t padding = (kBinaryAlignment - size % kBinaryAlignment) % kBinaryAlignment;
+
+    RecordFormatter::append_u32(size + padding, out);
+    RecordFormatter::append_u32(static_cast<std::uint32_t>(record.status), out);
+    RecordFormatter::append_u32(
+            is_error ? 0xFFFFFFFF : static_cast<std::uint32_t>(record.polynomial->crbegin()->first),
+            out);
+    RecordFormatter::append_u32(
+            is_error ? kBinaryNoSolutionType : static_cast<std::uint32_t>(record.type), out);
+    RecordFormatter::append_u32(term_count, out);
+    RecordFormatter::append_u32(solution_count, out);
+    RecordFormatter::append_u32(equation_length, out);
+    RecordFormatter::append_u32(error_length, out);
+
+    if (!is_error) {
+        for (auto itr = record.polynomial->crbegin(); itr != record.polynomial->crend(); ++itr) {
+            RecordFormatter::append_u32(static_cast<std::uint32_t>(itr->first), out);
+            RecordFormatter::append_u32(0, out);
+            RecordFormatter::append_f64(itr->second, out);
+        }
+        for (const QuadraticSolver::Solution &solution : *record.solutions) {
+            RecordFormatter::append_f64(solution.re, out);
+            RecordFormatter::append_f64(solution.im, out);
+        }
+    }
+    out->append(record.equation);
+    out->append(record.error);
+    for (std::uint32_t i = 0; i < padding; ++i) {
+        out->append('\0');
+    }
+}
+
+std::string_view RecordFormatter::solution_type_name(
+        QuadraticSolver::SolutionType type) noexcept(true) {
+    switch (type) {
+        case QuadraticSolver::TwoRealSolutionsQuadratic:
+            return "TwoRealSolutionsQuadratic";
+        case QuadraticSolver::TwoComplexSolutionsQuadratic:
+            return "TwoComplexSolutionsQuadratic";
+        case QuadraticSolver::OneRealSolutionQuadratic:
+            return "OneRealSolutionQuadratic";
+        case QuadraticSolver::ThreeRealSolutionsCubic:
+            return "ThreeRealSolutionsCubic";
+        case QuadraticSolver::OneRealTwoComplexSolutionsCubic:
+            return "OneRealTwoComplexSolutionsCubic";
+        case QuadraticSolver::MultipleRealSolutionsCubic:
+            return "MultipleRealSolutionsCubic";
+        case QuadraticSolver::FourRealSolutionsQuartic:
+            return "FourRealSolutionsQuartic";
+        case QuadraticSolver::TwoRealTwoComplexSolutionsQuartic:
+            return "TwoRealTwoComplexSolutionsQuartic";
+        case QuadraticSolver::FourComplexSolutionsQuartic:
+            return "FourComplexSolutionsQuartic";
+        case QuadraticSolver::SolutionsPolynomial:
+            return "SolutionsPolynomial";
+        case QuadraticSolver::OneRealSolutionLinear:
+            return "OneRealSolutionLinear";
+        case QuadraticSolver::Indeterminate:
+            return "Indeterminate";
+        case QuadraticSolver::NoSolution:
+            return "NoSolution";
+        case QuadraticSolver::NoSolutionDegreeTooHigh:
+            return "NoSolutionDegreeTooHigh";
+        case QuadraticSolver::NoSolutionDegreeTooLow:
+            return "NoSolutionDegreeTooLow";
+        case QuadraticSolver::NoSolutionCalculationError:
+            return "NoSolutionCalculationError";
+    }
+    return "Unknown";
+}
+
+// ", \, 制御文字をescapeする. それ以外のbyteはそのまま
+void RecordFormatter::append_json_string(std::string_view str, OutputBuffer *out) noexcept(true) {
+    const char kHex[] = "0123456789abcdef";
+
+    out->append('"');
+    for (char c : str) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out->append('\\');
+            out->append(c);
+        } else if (uc < 0x20) {
+            out->append("\\u00");
+            out->append(kHex[uc >> 4]);
+            out->append(kHex[uc & 0xF]);
+        } else {
+            out->append(c);
+        }
+    }
+    out->append('"');
+}
+
+// 往復変換できる最短表記. JSONで表せないinf, nanはnull
+void RecordFormatter::append_json_number(double num, OutputBuffer *out) noexcept(true) {
+    if (!std::isfinite(num)) {
+        out->append("null");
+        return;
+    }
+    char chars[32];
+    std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), num);
+    out->append(std::string_view(chars, static_cast<std::size_t>(result.ptr - chars)));
+}
+
+void RecordFormatter::append_u32(std::uint32_t num, OutputBuffer *out) noexcept(true) {
+    for (int i = 0; i < 4; ++i) {
+        out->append(static_cast<char>((num >> (8 * i)) & 0xFF));
+    }
+}
+
+void RecordFormatter::append_u64(std::uint64_t num, OutputBuffer *out) noexcept(true) {
+    for (int i = 0; i < 8; ++i) {
+        out->append(static_cast<char>((num >> (8 * i)) & 0xFF));
+    }
+}
+
+void RecordFormatter::append_f64(double num, OutputBuffer *out) noexcept(true) {
+    RecordFormatter::append_u64(std::bit_cast<std::uint64_t>(num), out);
+}
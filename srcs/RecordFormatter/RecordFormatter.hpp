@@ -0,0 +1,63 @@
+#pragma once
+
+# include <cstdint>
+# include <string_view>
+# include <vector>
+# include "Calculator.hpp"
+# include "computor.hpp"
+# include "OutputBuffer.hpp"
+# include "Polynomial.hpp"
+
+// 1つの方程式の結果. polynomial == nullptr の場合はparse error (errorにmessage)
+struct s_equation_record {
+    std::string_view equation;
+    int status;
+    const Polynomials *polynomial;
+    QuadraticSolver::SolutionType type;
+    const std::vector<QuadraticSolver::Solution> *solutions;
+    std::string_view error;
+};
+
+// 方程式の結果を機械向けの形式でOutputBufferに追加する
+// display_*の文字列ではなく、Parser::polynomial()とCalculatorの解から直接組み立てる
+//
+// JSON   : 1方程式1行 (JSON Lines). 数値は往復変換できる最短表記、inf, nanはnull
+//   {"equation":"x^2 = 1","status":0,"degree":2,
+//    "terms":[{"degree":2,"coefficient":1},{"degree":0,"coefficient":-1}],
+//    "type":"TwoRealSolutionsQuadratic","solutions":[{"re":1,"im":0},{"re":-1,"im":0}]}
+//   {"equation":"x +","status":1,"error":"syntax error: ..."}
+//
+// binary : 固定layoutのlittle-endian record. recordは8byte境界に揃え、連続して並べる
+//   offset size
+//        0    4  u32 record_size     (このrecordのbyte数. 次のrecordの位置)
+//        4    4  u32 status          (0: 解あり, 1: 解なし, error)
+//        8    4  i32 degree          (errorの場合は-1)
+//       12    4  u32 solution_type   (QuadraticSolver::SolutionTypeの値. errorの場合は0xFFFFFFFF)
+//       16    4  u32 term_count
+//       20    4  u32 solution_count
+//       24    4  u32 equation_length
+//       28    4  u32 error_length
+//       32   16  term     * term_count     : i32 degree, u32 0, f64 coefficient (次数の降順)
+//            16  solution * solution_count : f64 re, f64 im
+//                equation (UTF-8, 終端なし), error (終端なし), 0埋め
+class RecordFormatter {
+ public:
+    static constexpr std::uint32_t kBinaryHeaderSize = 32;
+    static constexpr std::uint32_t kBinaryAlignment = 8;
+    static constexpr std::uint32_t kBinaryNoSolutionType = 0xFFFFFFFF;
+
+    static void append(
+            const s_equation_record &record,
+            Computor::OutputFormat format,
+            OutputBuffer *out) noexcept(true);
+    static void append_json(const s_equation_record &record, OutputBuffer *out) noexcept(true);
+    static void append_binary(const s_equation_record &record, OutputBuffer *out) noexcept(true);
+    static std::string_view solution_type_name(QuadraticSolver::SolutionType type) noexcept(true);
+
+ private:
+    static void append_json_string(std::string_view str, OutputBuffer *out) noexcept(true);
+    static void append_json_number(double num, OutputBuffer *out) noexcept(true);
+    static void append_u32(std::uint32_t num, OutputBuffer *out) noexcept(true);
+    static void append_u64(std::uint64_t num, OutputBuffer *out) noexcept(true);
+    static void append_f64(double num, OutputBuffer *out) noexcept(true);
+};
@@ -0,0 +1,40 @@
+#include "ReorderBuffer.hpp"
+#include <utility>
+
+ReorderBuffer::ReorderBuffer()
+    : mutex_(),
+      ready_cv_(),
+      chunks_(),
+      next_sequence_(0) {}
+
+ReorderBuffer::~ReorderBuffer() {}
+
+void ReorderBuffer::put(std::size_t sequence, std::string &&chunk) noexcept(false) {
+    bool is_next;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->chunks_.emplace(sequence, std::move(chunk));
+        is_next = (sequence == this->next_sequence_);
+    }
+    if (is_next) {
+        this->ready_cv_.notify_one();
+    }
+}
+
+std::string ReorderBuffer::take() noexcept(true) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->ready_cv_.wait(lock, [this] {
+        return !this->chunks_.empty() && this->chunks_.begin()->first == this->next_sequence_;
+    });
+
+    std::string chunk = std::move(this->chunks_.begin()->second);
+    this->chunks_.erase(this->chunks_.begin());
+    ++this->next_sequence_;
+    return chunk;
+}
+
+// 次にtake()で取り出されるsequence (= 取り出し済みのchunk数)
+std::size_t ReorderBuffer::next_sequence() const noexcept(true) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->next_sequence_;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+# include <condition_variable>
+# include <cstddef>
+# include <map>
+# include <mutex>
+# include <string>
+
+// 順不同に完了したchunkを、連番 (sequence) 順に取り出すためのbuffer
+//   put  : 任意のthreadから、sequence番目のchunkを格納する
+//   take : 次のsequenceのchunkが揃うまで待ち、取り出す (1つのthreadから呼ぶ)
+class ReorderBuffer {
+ public:
+    ReorderBuffer();
+    ~ReorderBuffer();
+
+    void put(std::size_t sequence, std::string &&chunk) noexcept(false);
+    std::string take() noexcept(true);
+    std::size_t next_sequence() const noexcept(true);
+
+ private:
+    mutable std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::map<std::size_t, std::string> chunks_;
+    std::size_t next_sequence_;
+
+    // copy invalid
+    ReorderBuffer &operator=(const ReorderBuffer &rhs);
+    ReorderBuffer(const ReorderBuffer &other);
+};
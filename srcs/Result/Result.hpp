@@ -1,27 +1,59 @@
 #pragma once
 
+# include <cstddef>
+# include <type_traits>
+# include <variant>
+
+// OkType, ErrType のどちらか一方を保持する
+// OkTypeとErrTypeが同じ型でもよいよう、variantはindexで参照する
 template <typename OkType, typename ErrType>
 class Result {
  public:
 	Result();
 	Result(const Result &other);
+	Result(Result &&other) noexcept(kNothrowMove);
 	~Result();
 
 	Result &operator=(const Result &rhs);
+	Result &operator=(Result &&rhs) noexcept(kNothrowMoveAssign);
 
 	static Result ok(const OkType &value) noexcept(true);
+	static Result ok(OkType &&value) noexcept(kNothrowMove);
 	static Result err(const ErrType &value) noexcept(true);
+	static Result err(ErrType &&value) noexcept(kNothrowMove);
 
 	bool is_ok() const noexcept(true);
 	bool is_err() const noexcept(true);
 
-	OkType ok_value() const noexcept(false);
+	// rvalueのResultからは値をmoveして返す
+	const OkType &ok_value() const & noexcept(false);
+	OkType &ok_value() & noexcept(false);
+	OkType ok_value() && noexcept(false);
+
+	const ErrType &err_value() const & noexcept(false);
+	ErrType &err_value() & noexcept(false);
+	ErrType err_value() && noexcept(false);
 
-	ErrType err_value() const noexcept(false);
  private:
-	bool is_ok_;
-	OkType ok_value_;
-	ErrType err_value_;
+	static constexpr std::size_t kOk = 0;
+	static constexpr std::size_t kErr = 1;
+
+	// moveはOkType, ErrTypeのmoveがnoexceptの場合のみnoexcept
+	// (libstdc++のstd::dequeのmoveはheapを確保し、例外を投げうる)
+	static constexpr bool kNothrowMove =
+			std::is_nothrow_move_constructible_v<OkType>
+			&& std::is_nothrow_move_constructible_v<ErrType>;
+	static constexpr bool kNothrowMoveAssign =
+			kNothrowMove
+			&& std::is_nothrow_move_assignable_v<OkType>
+			&& std::is_nothrow_move_assignable_v<ErrType>;
+
+	std::variant<OkType, ErrType> value_;
+
+	template <std::size_t Index, typename... Args>
+	explicit Result(std::in_place_index_t<Index> index, Args &&...args);
+
+	void throw_if_not(std::size_t index) const noexcept(false);
 };
 
 #include "Result.tpp"
@@ -1,19 +1,28 @@
 #pragma once
 
 # include <stdexcept>
+# include <utility>
 
+// 既定はERROR. ErrTypeがdefault constructibleな場合のみ使用できる
 template <typename OkType, typename ErrType>
 Result<OkType, ErrType>::Result()
-    : is_ok_(false),
-      ok_value_(OkType()),
-      err_value_(ErrType()) {}
+    : value_(std::in_place_index<kErr>) {}
 
 
 template <typename OkType, typename ErrType>
 Result<OkType, ErrType>::Result(const Result &other)
-    : is_ok_(other.is_ok_),
-      ok_value_(other.ok_value_),
-      err_value_(other.err_value_) {}
+    : value_(other.value_) {}
+
+
+template <typename OkType, typename ErrType>
+Result<OkType, ErrType>::Result(Result &&other) noexcept(kNothrowMove)
+    : value_(std::move(other.value_)) {}
+
+
+template <typename OkType, typename ErrType>
+template <std::size_t Index, typename... Args>
+Result<OkType, ErrType>::Result(std::in_place_index_t<Index> index, Args &&...args)
+    : value_(index, std::forward<Args>(args)...) {}
 
 
 template <typename OkType, typename ErrType>
@@ -25,52 +34,103 @@ Result<OkType, ErrType> &Result<OkType, ErrType>::operator=(const Result &rhs) {
     if (this == &rhs) {
         return *this;
     }
-    is_ok_ = rhs.is_ok_;
-    ok_value_ = rhs.ok_value_;
-    err_value_ = rhs.err_value_;
+    value_ = rhs.value_;
+    return *this;
+}
+
+
+template <typename OkType, typename ErrType>
+Result<OkType, ErrType> &Result<OkType, ErrType>::operator=(Result &&rhs) noexcept(
+        kNothrowMoveAssign) {
+    if (this == &rhs) {
+        return *this;
+    }
+    value_ = std::move(rhs.value_);
     return *this;
 }
 
 
 template <typename OkType, typename ErrType>
 Result<OkType, ErrType> Result<OkType, ErrType>::ok(const OkType &value) noexcept(true) {
-    Result res;
-    res.is_ok_ = true;
-    res.ok_value_ = value;
-    return res;
+    return Result(std::in_place_index<kOk>, value);
 }
 
 
 template <typename OkType, typename ErrType>
-Result<OkType, ErrType>Result<OkType, ErrType>::err(const ErrType &value) noexcept(true) {
-    Result res;
-    res.is_ok_ = false;
-    res.err_value_ = value;
-    return res;
+Result<OkType, ErrType> Result<OkType, ErrType>::ok(OkType &&value) noexcept(kNothrowMove) {
+    return Result(std::in_place_index<kOk>, std::move(value));
 }
 
 
 template <typename OkType, typename ErrType>
-bool Result<OkType, ErrType>::is_ok() const noexcept(true) { return is_ok_; }
+Result<OkType, ErrType> Result<OkType, ErrType>::err(const ErrType &value) noexcept(true) {
+    return Result(std::in_place_index<kErr>, value);
+}
 
 
 template <typename OkType, typename ErrType>
-bool Result<OkType, ErrType>::is_err() const noexcept(true) { return !is_ok_; }
+Result<OkType, ErrType> Result<OkType, ErrType>::err(ErrType &&value) noexcept(kNothrowMove) {
+    return Result(std::in_place_index<kErr>, std::move(value));
+}
 
 
 template <typename OkType, typename ErrType>
-OkType Result<OkType, ErrType>::ok_value() const noexcept(false) {
-    if (is_ok_) {
-        return ok_value_;
-    }
-    throw std::runtime_error("[Result Error] Result is not OK");
+bool Result<OkType, ErrType>::is_ok() const noexcept(true) { return value_.index() == kOk; }
+
+
+template <typename OkType, typename ErrType>
+bool Result<OkType, ErrType>::is_err() const noexcept(true) { return value_.index() == kErr; }
+
+
+template <typename OkType, typename ErrType>
+const OkType &Result<OkType, ErrType>::ok_value() const & noexcept(false) {
+    throw_if_not(kOk);
+    return std::get<kOk>(value_);
+}
+
+
+template <typename OkType, typename ErrType>
+OkType &Result<OkType, ErrType>::ok_value() & noexcept(false) {
+    throw_if_not(kOk);
+    return std::get<kOk>(value_);
+}
+
+
+template <typename OkType, typename ErrType>
+OkType Result<OkType, ErrType>::ok_value() && noexcept(false) {
+    throw_if_not(kOk);
+    return std::get<kOk>(std::move(value_));
+}
+
+
+template <typename OkType, typename ErrType>
+const ErrType &Result<OkType, ErrType>::err_value() const & noexcept(false) {
+    throw_if_not(kErr);
+    return std::get<kErr>(value_);
+}
+
+
+template <typename OkType, typename ErrType>
+ErrType &Result<OkType, ErrType>::err_value() & noexcept(false) {
+    throw_if_not(kErr);
+    return std::get<kErr>(value_);
 }
 
 
 template <typename OkType, typename ErrType>
-ErrType Result<OkType, ErrType>::err_value() const noexcept(false) {
-    if (!is_ok_) {
-        return err_value_;
+ErrType Result<OkType, ErrType>::err_value() && noexcept(false) {
+    throw_if_not(kErr);
+    return std::get<kErr>(std::move(value_));
+}
+
+
+template <typename OkType, typename ErrType>
+void Result<OkType, ErrType>::throw_if_not(std::size_t index) const noexcept(false) {
+    if (value_.index() == index) {
+        return;
+    }
+    if (index == kOk) {
+        throw std::runtime_error("[Result Error] Result is not OK");
     }
     throw std::runtime_error("[Result Error] Result is not ERROR");
 }
@@ -0,0 +1,274 @@
+#include "RootFinder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+RootFinder::RootFinder(const s_root_finder_config &config)
+    : config_(config),
+      coefficients_(),
+      roots_(),
+      radii_(),
+      next_roots_(),
+      is_converged_(),
+      active_(),
+      thread_pool_(),
+      iterations_(0) {}
+
+RootFinder::~RootFinder() {}
+
+void RootFinder::set_config(const s_root_finder_config &config) noexcept(true) {
+    if (this->thread_pool_ && this->thread_pool_->size() != config.threads) {
+        this->thread_pool_.reset();
+    }
+    this->config_ = config;
+}
+
+Computor::Status RootFinder::solve(const std::vector<double> &coefficients) noexcept(false) {
+    return RootFinder::solve(std::span<const double>(coefficients));
+}
+
+// 収束しない (max_iterations回のsweepで全ての根が収束しない, nan/infになる) 場合はFAILURE
+// coefficientsはsolve()の間のみ参照する (pmr::vectorなど任意の連続した配列でよい)
+Computor::Status RootFinder::solve(std::span<const double> coefficients) noexcept(false) {
+    std::size_t degree = coefficients.size() - 1;
+
+    // X^0 ... X^(zero_roots - 1) の係数が0 -> X = 0 がzero_roots重解
+    std::size_t zero_roots = 0;
+    while (zero_roots < degree && coefficients[zero_roots] == 0.0) {
+        ++zero_roots;
+    }
+    this->coefficients_.assign(coefficients.begin() + zero_roots, coefficients.end());
+    this->roots_.assign(degree, 0.0);
+    this->radii_.assign(degree, 0.0);
+    this->is_converged_.assign(degree, 1);
+    this->iterations_ = 0;
+    if (zero_roots == degree) {
+        return Computor::SUCCESS;
+    }
+
+    RootFinder::init_roots(zero_roots);
+    bool is_parallel = 1 < this->config_.threads
+                       && Computor::ROOT_FINDER_PARALLEL_MIN_DEGREE <= degree - zero_roots;
+    bool is_all_converged = is_parallel ? RootFinder::solve_parallel(zero_roots)
+                                        : RootFinder::solve_sequential(zero_roots);
+
+    for (const std::complex<double> &root : this->roots_) {
+        if (!std::isfinite(root.real()) || !std::isfinite(root.imag())) {
+            return Computor::FAILURE;
+        }
+    }
+    if (!is_all_converged) {
+        return Computor::FAILURE;
+    }
+    for (std::size_t i = zero_roots; i < degree; ++i) {
+        this->radii_[i] = RootFinder::inclusion_radius(this->roots_[i]);
+    }
+    return Computor::SUCCESS;
+}
+
+const std::vector<std::complex<double>> &RootFinder::roots() const noexcept(true) {
+    return this->roots_;
+}
+
+// X = 0 の解 (deflation) の半径は0
+const std::vector<double> &RootFinder::radii() const noexcept(true) {
+    return this->radii_;
+}
+
+std::int32_t RootFinder::iterations() const noexcept(true) {
+    return this->iterations_;
+}
+
+// 初期値は半径 |c_0 / c_n|^(1/n) (根の絶対値の幾何平均) の円周上に等間隔に置く
+// 実軸に対して対称にならないよう偏角をずらす
+void RootFinder::init_roots(std::size_t zero_roots) noexcept(true) {
+    const std::size_t degree = this->coefficients_.size() - 1;
+    // |c0 / cn|はunder/overflowし得るため、半径はlog上で求める
+    const double radius = std::exp(
+            (std::log(std::abs(this->coefficients_.front()))
+             - std::log(std::abs(this->coefficients_.back())))
+            / static_cast<double>(degree));
+    const double kAngleOffset = 0.4;
+
+    for (std::size_t i = 0; i < degree; ++i) {
+        double angle = 2.0 * std::numbers::pi * static_cast<double>(i)
+                       / static_cast<double>(degree);
+        this->roots_[zero_roots + i] = std::polar(radius, angle + kAngleOffset);
+        this->is_converged_[zero_roots + i] = 0;
+    }
+}
+
+// 全ての根が収束した場合はtrue
+bool RootFinder::solve_sequential(std::size_t zero_roots) noexcept(true) {
+    const std::size_t degree = this->roots_.size();
+    bool is_all_converged = false;
+
+    while (!is_all_converged && this->iterations_ < this->config_.max_iterations) {
+        is_all_converged = true;
+        for (std::size_t i = zero_roots; i < degree; ++i) {
+            if (!this->is_converged_[i]) {
+                is_all_converged &= RootFinder::update_root(i, this->roots_, &this->roots_[i]);
+            }
+        }
+        ++this->iterations_;
+    }
+    return is_all_converged;
+}
+
+// 未収束の根 (active_) をblock_roots個ずつtaskに分け、thread poolで更新する
+// sweep毎にwait()で全taskを待ってから更新結果を反映し、収束した根をactive_から除く
+bool RootFinder::solve_parallel(std::size_t zero_roots) noexcept(false) {
+    const std::size_t degree = this->roots_.size();
+    const std::size_t block_roots = std::max<std::size_t>(this->config_.block_roots, 1);
+
+    if (!this->thread_pool_ || this->thread_pool_->size() != this->config_.threads) {
+        this->thread_pool_ = std::make_unique<ThreadPool>(this->config_.threads);
+    }
+    this->next_roots_.resize(degree);
+    this->active_.clear();
+    for (std::size_t i = zero_roots; i < degree; ++i) {
+        this->active_.push_back(i);
+    }
+
+    while (!this->active_.empty() && this->iterations_ < this->config_.max_iterations) {
+        for (std::size_t begin = 0; begin < this->active_.size(); begin += block_roots) {
+            std::size_t end = std::min(begin + block_roots, this->active_.size());
+            this->thread_pool_->submit([this, begin, end](std::size_t) {
+                for (std::size_t k = begin; k < end; ++k) {
+                    std::size_t i = this->active_[k];
+                    RootFinder::update_root(i, this->roots_, &this->next_roots_[i]);
+                }
+            });
+        }
+        this->thread_pool_->wait();
+
+        std::size_t remaining = 0;
+        for (std::size_t i : this->active_) {
+            this->roots_[i] = this->next_roots_[i];
+            if (!this->is_converged_[i]) {
+                this->active_[remaining++] = i;
+            }
+        }
+        this->active_.resize(remaining);
+        ++this->iterations_;
+    }
+    return this->active_.empty();
+}
+
+// Aberth-Ehrlich法で1つの根を更新し、nextに書く
+//   w = N / (1 - N * sum_{j != i} 1 / (z_i - z_j)),  N = p(z_i) / p'(z_i)
+// z_j はrootsから読む (逐次ではroots_自身, 並列では前のsweepのroots_)
+// |w| <= tolerance * |z_i|、またはp(z_i)が丸め誤差の範囲で0の場合に収束とする
+bool RootFinder::update_root(
+        std::size_t index,
+        const std::vector<std::complex<double>> &roots,
+        std::complex<double> *next) noexcept(true) {
+    const std::size_t zero_roots = roots.size() - (this->coefficients_.size() - 1);
+    const std::complex<double> z = roots[index];
+
+    bool is_exact = false;
+    std::complex<double> ratio = RootFinder::newton_ratio(z, &is_exact);
+    if (is_exact) {
+        *next = z;
+        this->is_converged_[index] = 1;
+        return true;
+    }
+
+    // 1 / d = conj(d) / |d|^2 (complexの除算はinf, nanの扱いのため遅い)
+    // |d|^2がunder/overflowする場合のみ、dを成分の絶対値の最大値で割ってから求める
+    double sum_re = 0.0;
+    double sum_im = 0.0;
+    for (std::size_t j = zero_roots; j < roots.size(); ++j) {
+        if (j != index) {
+            std::complex<double> d = z - roots[j];
+            double inv_norm = 1.0 / (d.real() * d.real() + d.imag() * d.imag());
+            if ((inv_norm == 0.0 || std::isinf(inv_norm)) && d != 0.0) {
+                double scale = std::max(std::abs(d.real()), std::abs(d.imag()));
+                d /= scale;
+                inv_norm = 1.0 / (d.real() * d.real() + d.imag() * d.imag()) / scale;
+            }
+            sum_re += d.real() * inv_norm;
+            sum_im -= d.imag() * inv_norm;
+        }
+    }
+    std::complex<double> sum(sum_re, sum_im);
+    std::complex<double> step = ratio / (1.0 - ratio * sum);
+    *next = z - step;
+
+    bool is_converged = std::abs(step) <= this->config_.tolerance * std::abs(z - step);
+    this->is_converged_[index] = is_converged ? 1 : 0;
+    return is_converged;
+}
+
+// p(z) / p'(z) をHorner法で求める
+// |z| > 1 では p(z) = z^n q(1/z) (qは係数を逆順にした多項式) を使い、z^nのoverflowを避ける
+//   p(z) / p'(z) = z q(y) / (n q(y) - y q'(y)),  y = 1 / z
+// is_exact : |p(z)|が評価の丸め誤差 (eps * sum |c_i| |z|^i) 以下
+std::complex<double> RootFinder::newton_ratio(
+        std::complex<double> z,
+        bool *is_exact) const noexcept(true) {
+    const std::size_t degree = this->coefficients_.size() - 1;
+    const double kErrorBound = 4.0 * std::numeric_limits<double>::epsilon();
+
+    if (std::abs(z) <= 1.0) {
+        std::complex<double> p = this->coefficients_[degree];
+        std::complex<double> dp = 0.0;
+        double bound = std::abs(p);
+        double abs_z = std::abs(z);
+        for (std::size_t i = degree; 0 < i; --i) {
+            dp = dp * z + p;
+            p = p * z + this->coefficients_[i - 1];
+            bound = bound * abs_z + std::abs(this->coefficients_[i - 1]);
+        }
+        *is_exact = std::abs(p) <= kErrorBound * bound;
+        return dp == 0.0 ? p : p / dp;
+    }
+
+    std::complex<double> y = 1.0 / z;
+    std::complex<double> q = this->coefficients_[0];
+    std::complex<double> dq = 0.0;
+    double bound = std::abs(q);
+    double abs_y = std::abs(y);
+    for (std::size_t i = 1; i <= degree; ++i) {
+        dq = dq * y + q;
+        q = q * y + this->coefficients_[i];
+        bound = bound * abs_y + std::abs(this->coefficients_[i]);
+    }
+    *is_exact = std::abs(q) <= kErrorBound * bound;
+    std::complex<double> denominator = static_cast<double>(degree) * q - y * dq;
+    return denominator == 0.0 ? z * q : z * q / denominator;
+}
+
+// zを中心とし、真の解を少なくとも1つ含む円の半径 (丸め誤差を含むNewton法の包含円)
+//   n (|p(z)| + 4 eps sum |c_i| |z|^i) / |p'(z)|
+// m重解の近似では |p / p'| ≒ |z - 解| / m のため、達成した精度 (約eps^(1/m)) を表す
+// |z| > 1 ではnewton_ratio()と同じく係数を逆順にした多項式を1 / zで評価する
+// p'(z) = 0 の場合はzが解 (|p(z)|が丸め誤差以下) なら0、それ以外はinf
+double RootFinder::inclusion_radius(std::complex<double> z) const noexcept(true) {
+    const std::size_t degree = this->coefficients_.size() - 1;
+    const double kErrorBound = 4.0 * std::numeric_limits<double>::epsilon();
+    const double n = static_cast<double>(degree);
+
+    bool is_inside = std::abs(z) <= 1.0;
+    std::complex<double> y = is_inside ? z : 1.0 / z;
+    double abs_y = std::abs(y);
+    std::complex<double> p = is_inside ? this->coefficients_[degree] : this->coefficients_[0];
+    std::complex<double> dp = 0.0;
+    double bound = std::abs(p);
+    for (std::size_t k = 1; k <= degree; ++k) {
+        const std::complex<double> &c = is_inside ? this->coefficients_[degree - k]
+                                                  : this->coefficients_[k];
+        dp = dp * y + p;
+        p = p * y + c;
+        bound = bound * abs_y + std::abs(c);
+    }
+    // |z| > 1 : p(z) = z^n q(y), p'(z) = z^(n-1) (n q(y) - y q'(y))
+    std::complex<double> denominator = is_inside ? dp : n * p - y * dp;
+    double error = std::abs(p) + kErrorBound * bound;
+    if (denominator == 0.0) {
+        return std::abs(p) <= kErrorBound * bound ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    double radius = n * error / std::abs(denominator);
+    return is_inside ? radius : radius * std::abs(z);
+}
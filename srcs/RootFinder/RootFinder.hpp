@@ -0,0 +1,69 @@
+#pragma once
+
+# include <complex>
+# include <cstdint>
+# include <memory>
+# include <span>
+# include <vector>
+# include "computor.hpp"
+# include "ThreadPool.hpp"
+
+// tolerance      : 収束判定 |step| <= tolerance * |z|
+// max_iterations : 全ての根の更新 (sweep) 回数の上限
+// threads        : 2以上かつ次数がROOT_FINDER_PARALLEL_MIN_DEGREE以上の場合、sweepを並列に行う
+// block_roots    : 並列時に1つのtaskで更新する根の数
+struct s_root_finder_config {
+    double tolerance = Computor::ROOT_FINDER_TOLERANCE;
+    std::int32_t max_iterations = Computor::ROOT_FINDER_MAX_ITERATIONS;
+    std::size_t threads = 1;
+    std::size_t block_roots = Computor::ROOT_FINDER_BLOCK_ROOTS;
+};
+
+// 任意次数の多項式の全ての複素数解をAberth-Ehrlich法で同時に求める
+//   coefficients[i] : X^i の係数. coefficients.back() != 0
+//   X = 0 の解は先に除き (deflation)、残りの多項式を反復で解く
+// 係数, 解はcomplex<double>の連続した配列に持ち、solve()を繰り返し呼んでも再利用する
+// radii()[i] は roots()[i] を中心とし真の解を含む円の半径 (達成した精度. 重解では約sqrt(eps))
+//
+// 逐次 : 更新した根を同じsweepの他の根の更新にすぐ使う (Gauss-Seidel)
+// 並列 : 前のsweepの根だけを読み、未収束の根をblock_roots個ずつのtaskに分けて更新する (Jacobi)
+//        sweep毎に全taskの終了を待つ. 結果はthread数によらない
+class RootFinder {
+ public:
+    explicit RootFinder(const s_root_finder_config &config = s_root_finder_config());
+    ~RootFinder();
+
+    // 配列のcapacityは保持する. thread数が変わる場合のみthread poolを破棄する
+    void set_config(const s_root_finder_config &config) noexcept(true);
+    Computor::Status solve(const std::vector<double> &coefficients) noexcept(false);
+    Computor::Status solve(std::span<const double> coefficients) noexcept(false);
+
+    const std::vector<std::complex<double>> &roots() const noexcept(true);
+    const std::vector<double> &radii() const noexcept(true);
+    std::int32_t iterations() const noexcept(true);
+
+ private:
+    s_root_finder_config config_;
+    std::vector<std::complex<double>> coefficients_;    // X^0 ... X^n (X = 0の解を除いた後)
+    std::vector<std::complex<double>> roots_;
+    std::vector<double> radii_;
+    std::vector<std::complex<double>> next_roots_;      // 並列時の更新先
+    std::vector<std::uint8_t> is_converged_;            // 並列時に別threadから書くためbool以外
+    std::vector<std::size_t> active_;                   // 並列時の未収束の根の番号
+    std::unique_ptr<ThreadPool> thread_pool_;
+    std::int32_t iterations_;
+
+    void init_roots(std::size_t zero_roots) noexcept(true);
+    bool solve_sequential(std::size_t zero_roots) noexcept(true);
+    bool solve_parallel(std::size_t zero_roots) noexcept(false);
+    bool update_root(
+            std::size_t index,
+            const std::vector<std::complex<double>> &roots,
+            std::complex<double> *next) noexcept(true);
+    std::complex<double> newton_ratio(std::complex<double> z, bool *is_exact) const noexcept(true);
+    double inclusion_radius(std::complex<double> z) const noexcept(true);
+
+    // copy invalid
+    RootFinder &operator=(const RootFinder &rhs);
+    RootFinder(const RootFinder &other);
+};
@@ -0,0 +1,129 @@
+#include "SolutionCache.hpp"
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+SolutionCache::SolutionCache(std::size_t capacity, std::size_t shards)
+    : shards_(),
+      capacity_(capacity),
+      hits_(0),
+      misses_(0) {
+    std::size_t max_shards = std::max<std::size_t>(capacity, 1);
+    std::size_t shard_count = std::clamp<std::size_t>(shards, 1, max_shards);
+    for (std::size_t i = 0; i < shard_count; ++i) {
+        this->shards_.push_back(std::make_unique<s_shard>());
+        // 端数は先頭のshardから1つずつ割り当てる
+        this->shards_.back()->capacity = capacity / shard_count + (i < capacity % shard_count);
+    }
+}
+
+SolutionCache::~SolutionCache() {}
+
+bool SolutionCache::find(
+        const Polynomials &polynomial,
+        s_cached_solution *solution) noexcept(false) {
+    return SolutionCache::find_by_key(SolutionCache::make_key(polynomial), solution);
+}
+
+// hitした場合はsolutionに書き、最近使ったものとして先頭に移す
+bool SolutionCache::find_by_key(const Key &key, s_cached_solution *solution) noexcept(false) {
+    s_shard &shard = SolutionCache::shard(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto itr = shard.index.find(key);
+        if (itr != shard.index.end()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+            *solution = itr->second->solution;
+            this->hits_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    this->misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void SolutionCache::insert(
+        const Polynomials &polynomial,
+        const s_cached_solution &solution) noexcept(false) {
+    SolutionCache::insert_by_key(SolutionCache::make_key(polynomial), solution);
+}
+
+// 既にある場合は値を置き換える. 容量を超えた場合は最も長く使われていないものを捨てる
+void SolutionCache::insert_by_key(
+        const Key &key,
+        const s_cached_solution &solution) noexcept(false) {
+    s_shard &shard = SolutionCache::shard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.capacity == 0) {
+        return;
+    }
+    auto itr = shard.index.find(key);
+    if (itr != shard.index.end()) {
+        itr->second->solution = solution;
+        shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+        return;
+    }
+    if (shard.entries.size() == shard.capacity) {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+    }
+    shard.entries.push_front(s_entry{key, solution});
+    shard.index.emplace(key, shard.entries.begin());
+}
+
+std::size_t SolutionCache::capacity() const noexcept(true) {
+    return this->capacity_;
+}
+
+std::size_t SolutionCache::size() const noexcept(true) {
+    std::size_t size = 0;
+    for (const std::unique_ptr<s_shard> &shard : this->shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->entries.size();
+    }
+    return size;
+}
+
+std::uint64_t SolutionCache::hits() const noexcept(true) {
+    return this->hits_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t SolutionCache::misses() const noexcept(true) {
+    return this->misses_.load(std::memory_order_relaxed);
+}
+
+SolutionCache::Key SolutionCache::make_key(const Polynomials &polynomial) noexcept(false) {
+    Key key;
+    SolutionCache::make_key(polynomial, &key);
+    return key;
+}
+
+// degreeの昇順に [degree, 係数のbit列, degree, 係数のbit列, ...]
+// keyは上書きし、capacityが足りる場合は確保しない
+void SolutionCache::make_key(const Polynomials &polynomial, Key *key) noexcept(false) {
+    key->clear();
+    key->reserve(polynomial.size() * 2);
+    for (const auto &[degree, coefficient] : polynomial) {
+        key->push_back(static_cast<std::uint64_t>(static_cast<std::uint32_t>(degree)));
+        key->push_back(std::bit_cast<std::uint64_t>(Computor::normalize_zero(coefficient)));
+    }
+}
+
+// 64bitの値を順にmixする (splitmix64のfinalizer)
+std::size_t SolutionCache::s_key_hash::operator()(const Key &key) const noexcept(true) {
+    std::uint64_t hash = key.size();
+    for (std::uint64_t value : key) {
+        hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+        hash ^= hash >> 31;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// unordered_mapのbucketと偏らないよう、hashの上位bitでshardを選ぶ
+SolutionCache::s_shard &SolutionCache::shard(const Key &key) noexcept(true) {
+    std::uint64_t hash = s_key_hash()(key);
+    return *this->shards_[(hash >> 32) % this->shards_.size()];
+}
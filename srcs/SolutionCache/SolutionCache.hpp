@@ -0,0 +1,74 @@
+#pragma once
+
+# include <atomic>
+# include <cstddef>
+# include <cstdint>
+# include <list>
+# include <memory>
+# include <mutex>
+# include <unordered_map>
+# include <vector>
+# include "Calculator.hpp"
+# include "computor.hpp"
+# include "Polynomial.hpp"
+
+struct s_cached_solution {
+    QuadraticSolver::SolutionType type;
+    std::vector<QuadraticSolver::Solution> solutions;
+};
+
+// 簡約後の多項式 -> 解 (SolutionType, solutions) のLRU cache
+//   key : 項ごとの (degree, 係数のbit列) の列. -0.0は0.0と同じkeyにする
+// keyのhashでshardに分け、shard毎にmutexとLRU listを持つ (別shardのkeyは並行に読み書きできる)
+// 容量はshardに均等に割り当て、shard内で最も長く使われていないものから捨てる
+// capacity == 0 の場合は何も保持しない
+// find_by_key(), insert_by_key()は呼び出し側のkeyを使う
+// (make_key(polynomial, &key)でkeyのcapacityを再利用できる)
+class SolutionCache {
+ public:
+    using Key = std::vector<std::uint64_t>;
+
+    explicit SolutionCache(
+            std::size_t capacity,
+            std::size_t shards = Computor::SOLUTION_CACHE_SHARDS);
+    ~SolutionCache();
+
+    bool find(const Polynomials &polynomial, s_cached_solution *solution) noexcept(false);
+    bool find_by_key(const Key &key, s_cached_solution *solution) noexcept(false);
+    void insert(const Polynomials &polynomial, const s_cached_solution &solution) noexcept(false);
+    void insert_by_key(const Key &key, const s_cached_solution &solution) noexcept(false);
+
+    std::size_t capacity() const noexcept(true);
+    std::size_t size() const noexcept(true);
+    std::uint64_t hits() const noexcept(true);
+    std::uint64_t misses() const noexcept(true);
+
+    static Key make_key(const Polynomials &polynomial) noexcept(false);
+    static void make_key(const Polynomials &polynomial, Key *key) noexcept(false);
+
+ private:
+    struct s_key_hash {
+        std::size_t operator()(const Key &key) const noexcept(true);
+    };
+    struct s_entry {
+        Key key;
+        s_cached_solution solution;
+    };
+    struct s_shard {
+        mutable std::mutex mutex;
+        std::list<s_entry> entries;     // 先頭が最近使ったもの
+        std::unordered_map<Key, std::list<s_entry>::iterator, s_key_hash> index;
+        std::size_t capacity = 0;
+    };
+
+    std::vector<std::unique_ptr<s_shard>> shards_;
+    std::size_t capacity_;
+    std::atomic<std::uint64_t> hits_;
+    std::atomic<std::uint64_t> misses_;
+
+    s_shard &shard(const Key &key) noexcept(true);
+
+    // copy invalid
+    SolutionCache &operator=(const SolutionCache &rhs);
+    SolutionCache(const SolutionCache &other);
+};
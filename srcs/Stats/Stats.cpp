@@ -0,0 +1,262 @@
+#include "Stats.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr std::size_t kNameWidth = 12;
+constexpr std::size_t kColumnWidth = 12;
+constexpr double kPercentiles[] = {0.5, 0.9, 0.99};
+
+}  // namespace
+
+Stats::Stats() : stages_(), counters_() {
+    Stats::clear();
+}
+
+Stats::~Stats() {}
+
+void Stats::record(Stage stage, std::uint64_t nanoseconds) noexcept(true) {
+    Stats::add(&this->stages_[stage], nanoseconds);
+}
+
+void Stats::count(Counter counter, std::uint64_t value) noexcept(true) {
+    Stats::add(&this->counters_[counter], value);
+}
+
+void Stats::count(const s_parse_counts &counts) noexcept(true) {
+    Stats::count(Tokens, counts.tokens);
+    Stats::count(Terms, counts.terms);
+    Stats::count(Insertions, counts.insertions);
+}
+
+// --batchのworker毎のStatsを1つにまとめる
+void Stats::merge(const Stats &other) noexcept(true) {
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        Stats::merge(&this->stages_[i], other.stages_[i]);
+    }
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        Stats::merge(&this->counters_[i], other.counters_[i]);
+    }
+}
+
+void Stats::clear() noexcept(true) {
+    s_histogram empty = {};
+    empty.min = std::numeric_limits<std::uint64_t>::max();
+    this->stages_.fill(empty);
+    this->counters_.fill(empty);
+}
+
+const Stats::s_histogram &Stats::stage(Stage stage) const noexcept(true) {
+    return this->stages_[stage];
+}
+
+const Stats::s_histogram &Stats::counter(Counter counter) const noexcept(true) {
+    return this->counters_[counter];
+}
+
+void Stats::format(Computor::OutputFormat format, OutputBuffer *out) const noexcept(true) {
+    if (format == Computor::TEXT) {
+        Stats::format_text(out);
+    } else {
+        Stats::format_json(out);
+    }
+}
+
+//   stage              count       sum        mean       p50 ...
+//   recognize            100     81234         812       767 ...
+// stageの値はns. countが0の行の値は全て0
+void Stats::format_text(OutputBuffer *out) const noexcept(true) {
+    Stats::append_text_header("stage (ns)", out);
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        Stats::append_text_row(stage_name(static_cast<Stage>(i)), this->stages_[i], out);
+    }
+    Stats::append_text_header("counter", out);
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        Stats::append_text_row(counter_name(static_cast<Counter>(i)), this->counters_[i], out);
+    }
+}
+
+// 1行のJSON. stagesの値はns, bucketsは空でないbucketの [上限, 件数]
+//   {"stages":{"recognize":{"count":1,"sum":812,...,"buckets":[[1023,1]]},...},
+//    "counters":{"tokens":{...},...}}
+void Stats::format_json(OutputBuffer *out) const noexcept(true) {
+    out->append("{\"stages\":{");
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        if (i != 0) {
+            out->append(',');
+        }
+        out->append('"');
+        out->append(stage_name(static_cast<Stage>(i)));
+        out->append("\":");
+        Stats::append_json_histogram(this->stages_[i], out);
+    }
+    out->append("},\"counters\":{");
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        if (i != 0) {
+            out->append(',');
+        }
+        out->append('"');
+        out->append(counter_name(static_cast<Counter>(i)));
+        out->append("\":");
+        Stats::append_json_histogram(this->counters_[i], out);
+    }
+    out->append("}}\n");
+}
+
+// 値を小さい順に並べたときの ceil(ratio * count) 番目を含むbucketの上限. [min, max] に収める
+std::uint64_t Stats::percentile(const s_histogram &histogram, double ratio) noexcept(true) {
+    if (histogram.count == 0) {
+        return 0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(
+            std::ceil(ratio * static_cast<double>(histogram.count)));
+    rank = std::clamp<std::uint64_t>(rank, 1, histogram.count);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += histogram.buckets[i];
+        if (rank <= seen) {
+            return std::clamp(Stats::bucket_upper(i), histogram.min, histogram.max);
+        }
+    }
+    return histogram.max;
+}
+
+std::size_t Stats::bucket(std::uint64_t value) noexcept(true) {
+    return value < 2 ? 0 : static_cast<std::size_t>(std::bit_width(value)) - 1;
+}
+
+// bucket indexに入る値の最大値
+std::uint64_t Stats::bucket_upper(std::size_t index) noexcept(true) {
+    if (index + 1 == kBuckets) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return (std::uint64_t(1) << (index + 1)) - 1;
+}
+
+std::string_view Stats::stage_name(Stage stage) noexcept(true) {
+    switch (stage) {
+        case Recognize: return "recognize";
+        case Tokenize: return "tokenize";
+        case Parse: return "parse";
+        case Reduce: return "reduce";
+        case Solve: return "solve";
+        case Format: return "format";
+        case Total: return "total";
+        case kStageCount: break;
+    }
+    return "unknown";
+}
+
+std::string_view Stats::counter_name(Counter counter) noexcept(true) {
+    switch (counter) {
+        case Tokens: return "tokens";
+        case Terms: return "terms";
+        case Insertions: return "insertions";
+        case kCounterCount: break;
+    }
+    return "unknown";
+}
+
+void Stats::add(s_histogram *histogram, std::uint64_t value) noexcept(true) {
+    ++histogram->count;
+    histogram->sum += value;
+    histogram->min = std::min(histogram->min, value);
+    histogram->max = std::max(histogram->max, value);
+    ++histogram->buckets[Stats::bucket(value)];
+}
+
+void Stats::merge(s_histogram *histogram, const s_histogram &other) noexcept(true) {
+    histogram->count += other.count;
+    histogram->sum += other.sum;
+    histogram->min = std::min(histogram->min, other.min);
+    histogram->max = std::max(histogram->max, other.max);
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        histogram->buckets[i] += other.buckets[i];
+    }
+}
+
+void Stats::append_text_header(std::string_view title, OutputBuffer *out) noexcept(true) {
+    const std::string_view kColumns[] = {"count", "sum", "mean", "p50", "p90", "p99", "max"};
+
+    out->append(title);
+    out->append(std::string(kNameWidth - title.size(), Computor::SP));
+    for (std::string_view column : kColumns) {
+        out->append(std::string(kColumnWidth - column.size(), Computor::SP));
+        out->append(column);
+    }
+    out->append('\n');
+}
+
+void Stats::append_text_row(
+        std::string_view name,
+        const s_histogram &histogram,
+        OutputBuffer *out) noexcept(true) {
+    bool is_empty = (histogram.count == 0);
+
+    out->append(name);
+    out->append(std::string(kNameWidth - name.size(), Computor::SP));
+    Stats::append_column(histogram.count, out);
+    Stats::append_column(histogram.sum, out);
+    Stats::append_column(is_empty ? 0 : histogram.sum / histogram.count, out);
+    for (double ratio : kPercentiles) {
+        Stats::append_column(Stats::percentile(histogram, ratio), out);
+    }
+    Stats::append_column(histogram.max, out);
+    out->append('\n');
+}
+
+void Stats::append_json_histogram(
+        const s_histogram &histogram,
+        OutputBuffer *out) noexcept(true) {
+    bool is_empty = (histogram.count == 0);
+
+    out->append("{\"count\":");
+    out->append(histogram.count);
+    out->append(",\"sum\":");
+    out->append(histogram.sum);
+    out->append(",\"min\":");
+    out->append(is_empty ? 0 : histogram.min);
+    out->append(",\"max\":");
+    out->append(histogram.max);
+    out->append(",\"mean\":");
+    out->append(is_empty ? 0 : histogram.sum / histogram.count);
+    out->append(",\"p50\":");
+    out->append(Stats::percentile(histogram, 0.5));
+    out->append(",\"p90\":");
+    out->append(Stats::percentile(histogram, 0.9));
+    out->append(",\"p99\":");
+    out->append(Stats::percentile(histogram, 0.99));
+    out->append(",\"buckets\":[");
+    bool is_first = true;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        if (histogram.buckets[i] == 0) {
+            continue;
+        }
+        if (!is_first) {
+            out->append(',');
+        }
+        is_first = false;
+        out->append('[');
+        out->append(Stats::bucket_upper(i));
+        out->append(',');
+        out->append(histogram.buckets[i]);
+        out->append(']');
+    }
+    out->append("]}");
+}
+
+// 幅kColumnWidthで右寄せ
+void Stats::append_column(std::uint64_t value, OutputBuffer *out) noexcept(true) {
+    char chars[kColumnWidth * 2];
+    std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+    std::size_t length = static_cast<std::size_t>(result.ptr - chars);
+    if (length < kColumnWidth) {
+        out->append(std::string(kColumnWidth - length, Computor::SP));
+    }
+    out->append(std::string_view(chars, length));
+}
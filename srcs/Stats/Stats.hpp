@@ -0,0 +1,139 @@
+#pragma once
+
+# include <array>
+# include <chrono>
+# include <cstddef>
+# include <cstdint>
+# include <string_view>
+# include "computor.hpp"
+# include "OutputBuffer.hpp"
+
+// 方程式1つ分のparseの計数. Parser::counts()
+//   tokens     : 読んだtoken数
+//   terms      : 項数
+//   insertions : polynomialに新しく追加した次数の数
+struct s_parse_counts {
+    std::uint64_t tokens;
+    std::uint64_t terms;
+    std::uint64_t insertions;
+};
+
+// calc_equation(), --batchのstage毎の時間 (ns) と方程式毎の計数をhistogramに集計する
+// histogramのbucket iは [2^i, 2^(i+1)) (bucket 0のみ [0, 2)). 分位点はbucketの上限で近似する
+//
+// COMPUTOR_STATS を定義しない場合、Timerは何もしない空のclassになり、
+// Parser, Pipelineの計測は if constexpr (Stats::kEnabled) で除かれる
+class Stats {
+ public:
+    // Recognize : Parser::recognize_equation (tokenize + parse. Reduceを含む)
+    // Tokenize  : Tokenizer::lex (recognizeが失敗した場合のみ)
+    // Parse     : Parser::parse_equation (recognizeが失敗した場合のみ. Reduceを含む)
+    // Reduce    : Parser::reduce
+    // Solve     : Calculator (cacheがあればcacheの検索を含む)
+    // Format    : 結果の書式化
+    // Total     : Pipeline::run全体
+    enum Stage {
+        Recognize,
+        Tokenize,
+        Parse,
+        Reduce,
+        Solve,
+        Format,
+        Total,
+        kStageCount,
+    };
+    enum Counter {
+        Tokens,
+        Terms,
+        Insertions,
+        kCounterCount,
+    };
+
+# ifdef COMPUTOR_STATS
+    static constexpr bool kEnabled = true;
+# else
+    static constexpr bool kEnabled = false;
+# endif
+    static constexpr std::size_t kBuckets = 64;
+
+    struct s_histogram {
+        std::uint64_t count;
+        std::uint64_t sum;
+        std::uint64_t min;
+        std::uint64_t max;
+        std::array<std::uint64_t, kBuckets> buckets;
+    };
+
+    class Timer;
+
+    Stats();
+    ~Stats();
+
+    void record(Stage stage, std::uint64_t nanoseconds) noexcept(true);
+    void count(Counter counter, std::uint64_t value) noexcept(true);
+    void count(const s_parse_counts &counts) noexcept(true);
+    void merge(const Stats &other) noexcept(true);
+    void clear() noexcept(true);
+
+    const s_histogram &stage(Stage stage) const noexcept(true);
+    const s_histogram &counter(Counter counter) const noexcept(true);
+
+    // format: TEXT, JSON (BINARYはJSONとして扱う)
+    void format(Computor::OutputFormat format, OutputBuffer *out) const noexcept(true);
+    void format_text(OutputBuffer *out) const noexcept(true);
+    void format_json(OutputBuffer *out) const noexcept(true);
+
+    static std::uint64_t percentile(const s_histogram &histogram, double ratio) noexcept(true);
+    static std::size_t bucket(std::uint64_t value) noexcept(true);
+    static std::uint64_t bucket_upper(std::size_t index) noexcept(true);
+    static std::string_view stage_name(Stage stage) noexcept(true);
+    static std::string_view counter_name(Counter counter) noexcept(true);
+
+ private:
+    std::array<s_histogram, kStageCount> stages_;
+    std::array<s_histogram, kCounterCount> counters_;
+
+    static void add(s_histogram *histogram, std::uint64_t value) noexcept(true);
+    static void merge(s_histogram *histogram, const s_histogram &other) noexcept(true);
+    static void append_text_header(std::string_view title, OutputBuffer *out) noexcept(true);
+    static void append_text_row(
+            std::string_view name,
+            const s_histogram &histogram,
+            OutputBuffer *out) noexcept(true);
+    static void append_json_histogram(
+            const s_histogram &histogram,
+            OutputBuffer *out) noexcept(true);
+    static void append_column(std::uint64_t value, OutputBuffer *out) noexcept(true);
+};
+
+// scopeの経過時間 (steady_clock) をstageに記録する. stats == nullptr なら記録しない
+# ifdef COMPUTOR_STATS
+class Stats::Timer {
+ public:
+    Timer(Stats *stats, Stats::Stage stage) noexcept(true)
+        : stats_(stats),
+          stage_(stage),
+          begin_(stats != nullptr ? std::chrono::steady_clock::now()
+                                  : std::chrono::steady_clock::time_point()) {}
+    ~Timer() {
+        if (this->stats_ != nullptr) {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - this->begin_;
+            this->stats_->record(this->stage_, static_cast<std::uint64_t>(elapsed.count()));
+        }
+    }
+
+ private:
+    Stats *stats_;
+    Stats::Stage stage_;
+    std::chrono::steady_clock::time_point begin_;
+
+    // copy invalid
+    Timer &operator=(const Timer &rhs);
+    Timer(const Timer &other);
+};
+# else
+class Stats::Timer {
+ public:
+    Timer(Stats *, Stats::Stage) noexcept(true) {}
+};
+# endif
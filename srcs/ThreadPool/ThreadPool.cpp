@@ -0,0 +1,111 @@
+#include "ThreadPool.hpp"
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : queues_(),
+      workers_(),
+      next_queue_(0),
+      mutex_(),
+      task_cv_(),
+      idle_cv_(),
+      queued_(0),
+      pending_(0),
+      stop_(false) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->queues_.push_back(std::make_unique<s_queue>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+// 積まれたtaskを全て実行してから終了する
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stop_ = true;
+    }
+    this->task_cv_.notify_all();
+    for (std::thread &worker : this->workers_) {
+        worker.join();
+    }
+}
+
+// submitは1つのthreadから呼ぶ. taskはround-robinで各workerのqueueへ配り、偏りはstealで均す
+void ThreadPool::submit(Task task) noexcept(false) {
+    s_queue &queue = *this->queues_[this->next_queue_];
+    this->next_queue_ = (this->next_queue_ + 1) % this->queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        ++this->queued_;
+        ++this->pending_;
+    }
+    this->task_cv_.notify_one();
+}
+
+// submit済みのtaskが全て終わるまで待つ
+void ThreadPool::wait() noexcept(true) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->idle_cv_.wait(lock, [this] { return this->pending_ == 0; });
+}
+
+std::size_t ThreadPool::size() const noexcept(true) {
+    return this->workers_.size();
+}
+
+void ThreadPool::worker_loop(std::size_t worker) noexcept(true) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->task_cv_.wait(lock, [this] { return this->stop_ || 0 < this->queued_; });
+            if (this->queued_ == 0) {
+                return;
+            }
+            --this->queued_;
+        }
+
+        Task task = ThreadPool::take_task(worker);
+        task(worker);
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        --this->pending_;
+        if (this->pending_ == 0) {
+            this->idle_cv_.notify_all();
+        }
+    }
+}
+
+// queued_を1減らしたworkerは、いずれかのqueueに自分の取り分が1つ以上あることが保証される
+// 自分のqueueは末尾 (直近にsubmitされたもの)、他workerのqueueは先頭から取る
+ThreadPool::Task ThreadPool::take_task(std::size_t worker) noexcept(true) {
+    const std::size_t size = this->queues_.size();
+
+    while (true) {
+        for (std::size_t i = 0; i < size; ++i) {
+            std::size_t victim = (worker + i) % size;
+            s_queue &queue = *this->queues_[victim];
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            Task task;
+            if (victim == worker) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return task;
+        }
+        std::this_thread::yield();
+    }
+}
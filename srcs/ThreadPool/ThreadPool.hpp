@@ -0,0 +1,52 @@
+#pragma once
+
+# include <condition_variable>
+# include <cstddef>
+# include <deque>
+# include <functional>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+// worker毎にtask queue (deque) を持つwork-stealing thread pool
+//   worker : 自分のqueueの末尾からpop, 空なら他workerのqueueの先頭からsteal
+//   task   : 実行したworkerの番号 (0 <= worker < size()) を受け取る
+//            worker毎の状態 (Pipelineなど) を番号で引くために使う. taskは例外を投げないこと
+class ThreadPool {
+ public:
+    using Task = std::function<void(std::size_t worker)>;
+
+    explicit ThreadPool(std::size_t threads);
+    ~ThreadPool();
+
+    void submit(Task task) noexcept(false);
+    void wait() noexcept(true);
+    std::size_t size() const noexcept(true);
+
+ private:
+    struct s_queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<s_queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::size_t next_queue_;
+
+    // queued_  : queueに積まれ、まだどのworkerも取得していないtask数
+    // pending_ : submit後、実行が終わっていないtask数
+    std::mutex mutex_;
+    std::condition_variable task_cv_;
+    std::condition_variable idle_cv_;
+    std::size_t queued_;
+    std::size_t pending_;
+    bool stop_;
+
+    void worker_loop(std::size_t worker) noexcept(true);
+    Task take_task(std::size_t worker) noexcept(true);
+
+    // copy invalid
+    ThreadPool &operator=(const ThreadPool &rhs);
+    ThreadPool(const ThreadPool &other);
+};
@@ -1,8 +1,11 @@
 #include "Tokenizer.hpp"
+#include <bit>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <utility>
 
-Tokenizer::Tokenizer() {}
+Tokenizer::Tokenizer() : base_char_('\0') {}
 
 Tokenizer::~Tokenizer() {}
 
@@ -24,182 +27,359 @@ Result<Tokens, ErrMsg> Tokenizer::tokenize(const std::string &equation) noexcept
     if (equation.empty()) {
         return Result<Tokens, ErrMsg>::err("invalid equation");
     }
-    std::deque<std::string> split = Tokenizer::split_equation(equation);
+    Result<Computor::Status, ErrMsg> lex_result = Tokenizer::lex(equation);
 
-    Tokens tokens = tagging(split);
-    this->tokens_ = split_coef_and_base(tokens);  // split [coef][var]
-    tagging_terms(&this->tokens_);                //         ^tag  ^tag
-    return validate_tokens();
+    this->tokens_.clear();
+    for (std::size_t idx = 0; idx < this->token_stream_.size(); ++idx) {
+        s_token token = {};
+        token.word = std::string(this->token_stream_.word(idx));
+        token.kind = this->token_stream_.kind(idx);
+        this->tokens_.push_back(token);
+    }
+    if (lex_result.is_err()) {
+        return Result<Tokens, ErrMsg>::err(std::move(lex_result).err_value());
+    }
+    return Result<Tokens, ErrMsg>::ok(this->tokens_);
+}
+
+// tokenize()と同じtaggingを入力の1回の走査で行う
+// token_stream_はequationを参照するため、equationはtoken_stream_より長く生存させること
+//   "2X^2 + 1 = 0" -> [2][X][^][2][+][1][=][0]
+//                     ^^ [coef][base]も走査中に分割
+// 文字種の判定はCharClassのbitmaskで64byteずつ行う
+Result<Computor::Status, ErrMsg> Tokenizer::lex(std::string_view equation) noexcept(true) {
+    Tokenizer::reset();
+    if (equation.empty()) {
+        return Result<Computor::Status, ErrMsg>::err("invalid equation");
+    }
+    return Tokenizer::lex_segment(equation);
+}
+
+// equationを分割したsegmentをlex()と同様にlexする
+// base charは前のsegmentから引き継ぐため、equationの先頭segmentの前にreset()すること
+// token_stream_は今回のsegmentのtokenのみを保持する
+Result<Computor::Status, ErrMsg> Tokenizer::lex_segment(std::string_view segment) noexcept(true) {
+    this->token_stream_.clear();
+    if (std::numeric_limits<std::uint32_t>::max() < segment.length()) {
+        return Result<Computor::Status, ErrMsg>::err("invalid equation: too long");
+    }
+    this->token_stream_.source = segment;
+
+    std::size_t len = segment.length();
+    std::size_t block_begin = 0;
+    CharClass::Masks masks = {};
+    Tokenizer::load_block(segment, block_begin, &masks);
+
+    std::size_t pos = 0;
+    while (pos < len) {
+        if (block_begin + CharClass::kBlockSize <= pos) {
+            block_begin = pos - pos % CharClass::kBlockSize;
+            Tokenizer::load_block(segment, block_begin, &masks);
+        }
+
+        // SP
+        std::uint64_t non_space = ~masks.space >> (pos - block_begin);
+        if (non_space == 0) {
+            pos = block_begin + CharClass::kBlockSize;
+            continue;
+        }
+        pos += std::countr_zero(non_space);
+        if (len <= pos) {
+            break;
+        }
+        std::size_t bit = pos - block_begin;
+
+        // operator
+        if ((masks.op >> bit) & 1) {
+            this->token_stream_.push(Tokenizer::operator_kind(segment[pos]), pos, 1);
+            ++pos;
+            continue;
+        }
+
+        // word
+        std::uint64_t delimiter = (masks.space | masks.op) >> bit;
+        if (delimiter == 0) {
+            // blockを跨ぐword
+            std::size_t end = pos;
+            while (end < len && !Tokenizer::is_delimiter(segment[end])) {
+                ++end;
+            }
+            Tokenizer::push_word(segment, pos, end - pos, &this->token_stream_);
+            pos = end;
+            continue;
+        }
+        std::size_t length = std::countr_zero(delimiter);
+        Tokenizer::push_word(masks, bit, pos, length, &this->token_stream_);
+        pos += length;
+    }
+    return validate_token_stream();
+}
+
+// lex()の1byteずつ判定する版. test, benchmarkでの比較用
+Result<Computor::Status, ErrMsg> Tokenizer::lex_by_char(std::string_view equation) noexcept(true) {
+    Tokenizer::reset();
+    if (equation.empty()) {
+        return Result<Computor::Status, ErrMsg>::err("invalid equation");
+    }
+    if (std::numeric_limits<std::uint32_t>::max() < equation.length()) {
+        return Result<Computor::Status, ErrMsg>::err("invalid equation: too long");
+    }
+    this->token_stream_.source = equation;
+
+    std::size_t pos = 0;
+    std::size_t len = equation.length();
+    while (pos < len) {
+        char c = equation[pos];
+        if (c == Computor::SP) {
+            ++pos;
+            continue;
+        }
+        TokenKind op_kind = Tokenizer::operator_kind(c);
+        if (op_kind != None) {
+            this->token_stream_.push(op_kind, pos, 1);
+            ++pos;
+            continue;
+        }
+        std::size_t end = pos;
+        while (end < len && !Tokenizer::is_delimiter(equation[end])) {
+            ++end;
+        }
+        Tokenizer::push_word(equation, pos, end - pos, &this->token_stream_);
+        pos = end;
+    }
+    return validate_token_stream();
 }
 
 const Tokens &Tokenizer::tokens() noexcept(true) {
     return this->tokens_;
 }
 
+const TokenStream &Tokenizer::token_stream() const noexcept(true) {
+    return this->token_stream_;
+}
 
-////////////////////////////////////////////////////////////////////////////////
+// lex前の状態に戻す. token_stream_のcapacityは保持し、次の方程式で再利用する
+void Tokenizer::reset() noexcept(true) {
+    this->tokens_.clear();
+    this->token_stream_.clear();
+    this->base_char_ = '\0';
+}
 
 
-std::deque<std::string> Tokenizer::split_equation(
-        const std::string &equation) noexcept(true) {
-    std::deque<std::string> split;
+////////////////////////////////////////////////////////////////////////////////
+
 
-    // equation
-    split = Tokenizer::split_by_delimiter(equation, Computor::SP);
+TokenStream::TokenStream() : TokenStream(std::pmr::get_default_resource()) {}
 
-    // expression
-    bool keep_delimiter = true;
-    split = Tokenizer::split_by_delimiter(split, Computor::OP_EQUAL, keep_delimiter);
+TokenStream::TokenStream(std::pmr::memory_resource *resource)
+    : source(),
+      kinds(resource),
+      offsets(resource),
+      lengths(resource),
+      values(resource) {}
 
-    // term
-    split = Tokenizer::split_by_delimiter(split, Computor::OP_MUL, keep_delimiter);
-    split = Tokenizer::split_by_delimiter(split, Computor::OP_PLUS, keep_delimiter);
-    split = Tokenizer::split_by_delimiter(split, Computor::OP_MINUS, keep_delimiter);
-    split = Tokenizer::split_by_delimiter(split, Computor::OP_POW, keep_delimiter);
-    return split;
+std::size_t TokenStream::size() const noexcept(true) {
+    return this->kinds.size();
 }
 
-std::deque<std::string> Tokenizer::split_by_delimiter(
-        const std::string &src,
-        char delimiter,
-        bool keep_delimiter) noexcept(true) {
-    std::deque<std::string> split = {};
-    std::string token = "";
-
-    for (char c : src) {
-        if (c != delimiter) {
-            token += c;
-        } else {
-            if (!token.empty()) {
-                split.push_back(token);
-                token.clear();
-            }
-            if (keep_delimiter) {
-                split.push_back(std::string(1, c));
-            }
-        }
-    }
+bool TokenStream::empty() const noexcept(true) {
+    return this->kinds.empty();
+}
 
-    if (!token.empty()) {
-        split.push_back(token);
-    }
-    return split;
+TokenKind TokenStream::kind(std::size_t idx) const noexcept(true) {
+    return static_cast<TokenKind>(this->kinds[idx]);
 }
 
-std::deque<std::string> Tokenizer::split_by_delimiter(
-        const std::deque<std::string> &src,
-        char delimiter,
-        bool keep_delimiter) noexcept(true) {
-    std::deque<std::string> split, split_elem;
+std::string_view TokenStream::word(std::size_t idx) const noexcept(true) {
+    return this->source.substr(this->offsets[idx], this->lengths[idx]);
+}
 
-    for (const auto &itr : src) {
-        split_elem = split_by_delimiter(itr, delimiter, keep_delimiter);
-        split.insert(split.end(), split_elem.begin(), split_elem.end());
-    }
+double TokenStream::value(std::size_t idx) const noexcept(true) {
+    return this->values[idx];
+}
 
-    return split;
+void TokenStream::clear() noexcept(true) {
+    this->source = std::string_view();
+    this->kinds.clear();
+    this->offsets.clear();
+    this->lengths.clear();
+    this->values.clear();
 }
 
-// kind none -> split [digit][alpha], like 2X -> [2][X]
-// isalpha()までをdigitと判定するため、is_integer(), is_decimal()で評価
-// alphaは先頭がisalphaであることのみ保証
-// -> num, alphaともにtaggingで再評価されるため、分離できていればOK
-Tokens Tokenizer::split_coef_and_base(const Tokens &tokens) noexcept(true) {
-    Tokens split, new_tokens;
-
-    for (auto &token : tokens) {
-        new_tokens = {};
-
-        std::string word;
-        if (token.kind == None && std::isdigit(token.word[0])) {
-            std::size_t pos = 0;
-            while (token.word[pos] && !std::isalpha(token.word[pos])) {
-                ++pos;
-            }
-            std::string num = token.word.substr(0, pos);
-            if ((Tokenizer::is_integer(num) || Tokenizer::is_decimal(num))) {
-                std::string alpha = token.word.substr(pos);
-                s_token coef_token = {}; coef_token.word = num;
-                s_token base_token = {}; base_token.word = alpha;
-                new_tokens.push_back(coef_token);
-                new_tokens.push_back(base_token);
-            }
-        }
+// Integer, Decimalはpush時にdecodeし、parserでの再変換を不要にする
+void TokenStream::push(TokenKind kind, std::size_t offset, std::size_t length) noexcept(true) {
+    double value = 0.0;
+    if (kind == Integer || kind == Decimal) {
+        std::pair<Computor::Status, double> result;
+        result = Computor::stod(this->source.substr(offset, length));
+        value = result.first == Computor::SUCCESS
+                ? result.second : std::numeric_limits<double>::quiet_NaN();
+    }
+    this->kinds.push_back(static_cast<std::uint8_t>(kind));
+    this->offsets.push_back(static_cast<std::uint32_t>(offset));
+    this->lengths.push_back(static_cast<std::uint32_t>(length));
+    this->values.push_back(value);
+}
 
-        if (new_tokens.empty()) {
-            new_tokens.push_back(token);
-        }
+// Tokensのwordを連結してsourceとし、streamに変換する
+// streamはsourceを参照するため、sourceはstreamより長く生存させること
+void TokenStream::assign(const Tokens &tokens, std::pmr::string *source) noexcept(true) {
+    if (!source) { return; }
 
-        split.insert(split.end(), new_tokens.begin(), new_tokens.end());
+    TokenStream::clear();
+    source->clear();
+    for (const auto &token : tokens) {
+        source->append(token.word);
     }
+    this->source = *source;
 
-    return split;
+    std::size_t offset = 0;
+    for (const auto &token : tokens) {
+        TokenStream::push(token.kind, offset, token.word.length());
+        offset += token.word.length();
+    }
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 
 
-Tokens Tokenizer::tagging(const std::deque<std::string> &split) noexcept(true) {
-    Tokens tokens = Tokenizer::init_tokens(split);
-    Tokenizer::tagging_operators(&tokens);
-    Tokenizer::tagging_terms(&tokens);
-    return tokens;
+bool Tokenizer::is_delimiter(char c) noexcept(true) {
+    return c == Computor::SP || Tokenizer::operator_kind(c) != None;
 }
 
-Tokens Tokenizer::init_tokens(const std::deque<std::string> &split) noexcept(true) {
-    Tokens tokens = {};
+TokenKind Tokenizer::operator_kind(char c) noexcept(true) {
+    switch (c) {
+        case Computor::OP_PLUS:
+            return OperatorPlus;
+        case Computor::OP_MINUS:
+            return OperatorMinus;
+        case Computor::OP_MUL:
+            return OperatorMul;
+        case Computor::OP_EQUAL:
+            return OperatorEqual;
+        case Computor::OP_POW:
+            return TermPowSymbol;
+        default:
+            return None;
+    }
+}
 
-    for (auto itr = split.cbegin(); itr != split.cend(); ++itr) {
-        s_token token = {};
-        token.word = *itr;
-        token.kind = None;
-        tokens.push_back(token);
+TokenKind Tokenizer::word_kind(std::string_view word) noexcept(true) {
+    if (Tokenizer::is_char(word)) {
+        return Char;
+    }
+    if (Tokenizer::is_integer(word)) {
+        return Integer;
     }
-    return tokens;
+    if (Tokenizer::is_decimal(word)) {
+        return Decimal;
+    }
+    return None;
 }
 
-void Tokenizer::tagging_operators(Tokens *tokens) noexcept(true) {
-    if (!tokens) { return; }
-    // +, -, =, *, ^
-    for (auto &token : *tokens) {
-        if (token.word == std::string(1, Computor::OP_PLUS)) {
-            token.kind = OperatorPlus;
-        } else if (token.word == std::string(1, Computor::OP_MINUS)) {
-            token.kind = OperatorMinus;
-        } else if (token.word == std::string(1, Computor::OP_MUL)) {
-            token.kind = OperatorMul;
-        } else if (token.word == std::string(1, Computor::OP_EQUAL)) {
-            token.kind = OperatorEqual;
-        } else if (token.word == std::string(1, Computor::OP_POW)) {
-            token.kind = TermPowSymbol;
+// kind noneかつ先頭がdigitのwordは[digit][alpha]に分割, like 2X -> [2][X]
+void Tokenizer::push_word(
+        std::string_view source,
+        std::size_t offset,
+        std::size_t length,
+        TokenStream *stream) noexcept(true) {
+    if (!stream) { return; }
+
+    std::string_view word = source.substr(offset, length);
+    TokenKind kind = Tokenizer::word_kind(word);
+    if (kind == None && std::isdigit(word[0])) {
+        std::size_t pos = 0;
+        while (pos < length && !std::isalpha(word[pos])) {
+            ++pos;
+        }
+        TokenKind num_kind = Tokenizer::word_kind(word.substr(0, pos));
+        if (num_kind == Integer || num_kind == Decimal) {
+            std::string_view alpha = word.substr(pos);
+            stream->push(num_kind, offset, pos);
+            stream->push(Tokenizer::is_char(alpha) ? Char : None, offset + pos, length - pos);
+            return;
         }
     }
+    stream->push(kind, offset, length);
+}
+
+// block_begin以降の64byteを分類. 入力の末尾以降はSPとして扱う
+void Tokenizer::load_block(
+        std::string_view source,
+        std::size_t block_begin,
+        CharClass::Masks *masks) noexcept(true) {
+    std::size_t len = source.length() - block_begin;
+    CharClass::classify(source.data() + block_begin, len, masks);
+    if (len < CharClass::kBlockSize) {
+        masks->space |= ~std::uint64_t(0) << len;
+    }
+}
+
+// [bit, bit + length)のbitが立ったmask
+std::uint64_t Tokenizer::range_mask(std::size_t bit, std::size_t length) noexcept(true) {
+    if (length == 0) { return 0; }
+    if (CharClass::kBlockSize <= length) { return ~std::uint64_t(0); }
+    return ((std::uint64_t(1) << length) - 1) << bit;
+}
+
+// word_kind()のbitmask版. rangeはwordのbit範囲
+TokenKind Tokenizer::word_kind(const CharClass::Masks &masks, std::uint64_t range) noexcept(true) {
+    if (range == 0) { return None; }
+
+    int length = std::popcount(range);
+    int digits = std::popcount(masks.digit & range);
+    if (length == 1 && (masks.alpha & range)) {
+        return Char;
+    }
+    if (digits == length) {
+        return Integer;
+    }
+    std::uint64_t first = range & (~range + 1);
+    std::uint64_t last = std::uint64_t(1) << (63 - std::countl_zero(range));
+    if (std::popcount(masks.dot & range) == 1
+        && digits == length - 1
+        && (masks.digit & first)
+        && (masks.digit & last)) {
+        return Decimal;
+    }
+    return None;
 }
 
-void Tokenizer::tagging_terms(Tokens *tokens) noexcept(true) {
-    if (!tokens) { return; }
-    // aX^b
-    // ^^ ^ tagging
-    for (auto &token : *tokens) {
-        if (token.kind != None) { continue; }
-
-        if (Tokenizer::is_char(token.word)) {
-            token.kind = Char;
-        } else if (Tokenizer::is_integer(token.word)) {
-            token.kind = Integer;
-        } else if (Tokenizer::is_decimal(token.word)) {
-            token.kind = Decimal;
+// push_word()のbitmask版. wordはblock内の[bit, bit + length)に収まること
+void Tokenizer::push_word(
+        const CharClass::Masks &masks,
+        std::size_t bit,
+        std::size_t offset,
+        std::size_t length,
+        TokenStream *stream) noexcept(true) {
+    if (!stream) { return; }
+
+    std::uint64_t range = Tokenizer::range_mask(bit, length);
+    TokenKind kind = Tokenizer::word_kind(masks, range);
+    if (kind == None && ((masks.digit >> bit) & 1)) {
+        std::uint64_t alpha = masks.alpha & range;
+        std::size_t pos = alpha ? std::countr_zero(alpha) - bit : length;
+        TokenKind num_kind = Tokenizer::word_kind(masks, Tokenizer::range_mask(bit, pos));
+        if (num_kind == Integer || num_kind == Decimal) {
+            stream->push(num_kind, offset, pos);
+            stream->push(length - pos == 1 ? Char : None, offset + pos, length - pos);
+            return;
         }
     }
+    stream->push(kind, offset, length);
 }
 
-bool Tokenizer::is_char(const std::string &str) noexcept(true) {
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+bool Tokenizer::is_char(std::string_view str) noexcept(true) {
     return (str.length() == 1 && std::isalpha(str[0]));
 }
 
 //  integer     = 1*DIGIT
-bool Tokenizer::is_integer(const std::string &str) noexcept(true) {
+bool Tokenizer::is_integer(std::string_view str) noexcept(true) {
     if (str.empty()) { return false; }
     for (auto c : str) {
         if (!std::isdigit(c)) { return false; }
@@ -208,19 +388,20 @@ bool Tokenizer::is_integer(const std::string &str) noexcept(true) {
 }
 
 //  decimal     = 1*DIGIT "." 1*DIGIT
-bool Tokenizer::is_decimal(const std::string &str) noexcept(true) {
+bool Tokenizer::is_decimal(std::string_view str) noexcept(true) {
     if (str.empty()) { return false; }
 
+    std::size_t len = str.length();
     std::size_t int_len = 0;
-    while (std::isdigit(str[int_len])) {
+    while (int_len < len && std::isdigit(str[int_len])) {
         ++int_len;
     }
-    if (int_len == 0 || str[int_len] != '.') { return false; }
+    if (int_len == 0 || int_len == len || str[int_len] != '.') { return false; }
     std::size_t frac_len = 0;
-    while (std::isdigit(str[int_len + 1 + frac_len])) {
+    while (int_len + 1 + frac_len < len && std::isdigit(str[int_len + 1 + frac_len])) {
         ++frac_len;
     }
-    if (frac_len == 0 || str[int_len + 1 + frac_len]) { return false; }
+    if (frac_len == 0 || int_len + 1 + frac_len < len) { return false; }
     return true;
 }
 
@@ -228,42 +409,27 @@ bool Tokenizer::is_decimal(const std::string &str) noexcept(true) {
 ////////////////////////////////////////////////////////////////////////////////
 
 
-/*
- equation    = 1*expression "=" 1*expression
- expression  = 1*[ *(SP) term *(SP) ]
- term        = [ *(SP) operator *(SP) ] [ coefficient ( *(SP) "*" *(SP) ) ] base "^" power
- operator    = "+" / "-"
- coefficient = integer / decimal
- power       = integer
- decimal     = 1*DIGIT "." 1*DIGIT
- integer     = 1*DIGIT
- base        = ALPHA
- ALPHA       = A-Z / a-z
- DIGIT       = 0-9
- SP          = " "
- */
-Result<Tokens, ErrMsg> Tokenizer::validate_tokens() const noexcept(true) {
-    // std::string prev_word;
-    char base_char = '\0';
-
-    for (auto &token : this->tokens_) {
-        if (token.kind == None) {
+// base charはsegmentを跨いでbase_char_に保持する
+Result<Computor::Status, ErrMsg> Tokenizer::validate_token_stream() noexcept(true) {
+    for (std::size_t idx = 0; idx < this->token_stream_.size(); ++idx) {
+        TokenKind kind = this->token_stream_.kind(idx);
+        std::string_view word = this->token_stream_.word(idx);
+        if (kind == None) {
             std::ostringstream err_oss;
-            err_oss << "syntax error: unexpected token near: " << token.word << "";
-            return Result<Tokens, ErrMsg>::err(err_oss.str());
+            err_oss << "syntax error: unexpected token near: " << word << "";
+            return Result<Computor::Status, ErrMsg>::err(err_oss.str());
         }
-        if (token.kind == Char) {
-            if (base_char == '\0') {
-                base_char = token.word[0];
+        if (kind == Char) {
+            if (this->base_char_ == '\0') {
+                this->base_char_ = word[0];
                 continue;
             }
-            if (base_char != token.word[0]) {
+            if (this->base_char_ != word[0]) {
                 std::ostringstream err_oss;
-                err_oss << "syntax error: unexpected token near: " << token.word << "";
-                return Result<Tokens, ErrMsg>::err(err_oss.str());
+                err_oss << "syntax error: unexpected token near: " << word << "";
+                return Result<Computor::Status, ErrMsg>::err(err_oss.str());
             }
         }
-        // prev_word = token.word;
     }
-    return Result<Tokens, ErrMsg>::ok(this->tokens_);
+    return Result<Computor::Status, ErrMsg>::ok(Computor::Status::SUCCESS);
 }
@@ -1,12 +1,17 @@
 #pragma once
 
+# include <cstdint>
 # include <deque>
+# include <memory_resource>
 # include <string>
+# include <string_view>
+# include <vector>
 # include "computor.hpp"
+# include "CharClass.hpp"
 # include "Result.hpp"
 
 
-enum TokenKind {
+enum TokenKind : std::uint8_t {
     None = 0,
     Char,
     Integer,
@@ -27,44 +32,82 @@ struct s_token {
 using Tokens = std::deque<s_token>;
 
 
+// lex()の出力. token iの情報は各配列のi番目に格納 (struct of arrays)
+//   word : source[offset, offset + length), lex()に渡した入力バッファを参照
+//   value: Integer, Decimalの数値. 範囲外はNaN
+// 配列はresource (既定はstd::pmr::get_default_resource()) から確保する
+struct TokenStream {
+    std::string_view source;
+    std::pmr::vector<std::uint8_t> kinds;
+    std::pmr::vector<std::uint32_t> offsets;
+    std::pmr::vector<std::uint32_t> lengths;
+    std::pmr::vector<double> values;
+
+    TokenStream();
+    explicit TokenStream(std::pmr::memory_resource *resource);
+
+    std::size_t size() const noexcept(true);
+    bool empty() const noexcept(true);
+    TokenKind kind(std::size_t idx) const noexcept(true);
+    std::string_view word(std::size_t idx) const noexcept(true);
+    double value(std::size_t idx) const noexcept(true);
+
+    void clear() noexcept(true);
+    void push(TokenKind kind, std::size_t offset, std::size_t length) noexcept(true);
+    void assign(const Tokens &tokens, std::pmr::string *source) noexcept(true);
+};
+
+
 class Tokenizer {
  public:
     Tokenizer();
     ~Tokenizer();
 
     Result<Tokens, ErrMsg> tokenize(const std::string &equation) noexcept(true);
+    Result<Computor::Status, ErrMsg> lex(std::string_view equation) noexcept(true);
+    Result<Computor::Status, ErrMsg> lex_segment(std::string_view segment) noexcept(true);
+    Result<Computor::Status, ErrMsg> lex_by_char(std::string_view equation) noexcept(true);
     const Tokens &tokens() noexcept(true);
+    const TokenStream &token_stream() const noexcept(true);
+    void reset() noexcept(true);
 
     friend class TestTokenizer;
 
  private:
     Tokens tokens_;
-
-    // split
-    static std::deque<std::string> split_equation(
-            const std::string &equation) noexcept(true);
-    static std::deque<std::string> split_by_delimiter(
-            const std::string &src,
-            char delimiter,
-            bool keep_delimiter = false) noexcept(true);
-    static std::deque<std::string> split_by_delimiter(
-            const std::deque<std::string> &src,
-            char delimiter,
-            bool keep_delimiter = false) noexcept(true);
-    static Tokens split_coef_and_base(const Tokens &tokens) noexcept(true);
-
-    // tag
-    static Tokens tagging(const std::deque<std::string> &split) noexcept(true);
-    static Tokens init_tokens(const std::deque<std::string> &split) noexcept(true);
-    static void tagging_operators(Tokens *tokens) noexcept(true);
-    static void tagging_terms(Tokens *tokens) noexcept(true);
-
-    static bool is_char(const std::string &str) noexcept(true);
-    static bool is_integer(const std::string &str) noexcept(true);
-    static bool is_decimal(const std::string &str) noexcept(true);
+    TokenStream token_stream_;
+    char base_char_;
+
+    // lex
+    static bool is_delimiter(char c) noexcept(true);
+    static TokenKind operator_kind(char c) noexcept(true);
+    static TokenKind word_kind(std::string_view word) noexcept(true);
+    static void push_word(
+            std::string_view source,
+            std::size_t offset,
+            std::size_t length,
+            TokenStream *stream) noexcept(true);
+
+    // lex (bitmask)
+    static void load_block(
+            std::string_view source,
+            std::size_t block_begin,
+            CharClass::Masks *masks) noexcept(true);
+    static std::uint64_t range_mask(std::size_t bit, std::size_t length) noexcept(true);
+    static TokenKind word_kind(const CharClass::Masks &masks, std::uint64_t range) noexcept(true);
+    static void push_word(
+            const CharClass::Masks &masks,
+            std::size_t bit,
+            std::size_t offset,
+            std::size_t length,
+            TokenStream *stream) noexcept(true);
+
+    static bool is_char(std::string_view str) noexcept(true);
+    static bool is_integer(std::string_view str) noexcept(true);
+    static bool is_decimal(std::string_view str) noexcept(true);
 
     // validate
-    Result<Tokens, ErrMsg> validate_tokens() const noexcept(true);
+    Result<Computor::Status, ErrMsg> validate_token_stream() noexcept(true);
 
 
     // copy invalid
@@ -0,0 +1,137 @@
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include "OutputBuffer.hpp"
+
+namespace {
+
+// 登録済みの全threadのBuffer. threadの終了後もexitまで保持する
+struct s_trace_registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Trace::Buffer>> buffers;
+};
+
+s_trace_registry &registry() {
+    static s_trace_registry registry;
+    return registry;
+}
+
+std::uint64_t now() noexcept(true) {
+    std::chrono::nanoseconds time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(time.count());
+}
+
+}  // namespace
+
+Trace::Buffer::Buffer(std::size_t thread_index)
+    : events_(),
+      head_(0),
+      tail_(0),
+      thread_index_(thread_index) {}
+
+Trace::Buffer::~Buffer() {}
+
+void Trace::Buffer::push(const s_trace_event &event) noexcept(true) {
+    std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+    this->events_[head % kBufferEvents] = event;
+    this->head_.store(head + 1, std::memory_order_release);
+}
+
+// 未出力のeventをeventsに追加する. 上書きされて失ったevent数をdroppedに加える
+void Trace::Buffer::drain(
+        std::vector<s_trace_event> *events,
+        std::uint64_t *dropped) noexcept(true) {
+    std::uint64_t head = this->head_.load(std::memory_order_acquire);
+    if (this->tail_ + kBufferEvents < head) {
+        *dropped += head - kBufferEvents - this->tail_;
+        this->tail_ = head - kBufferEvents;
+    }
+    for (; this->tail_ < head; ++this->tail_) {
+        events->push_back(this->events_[this->tail_ % kBufferEvents]);
+    }
+}
+
+std::size_t Trace::Buffer::thread_index() const noexcept(true) {
+    return this->thread_index_;
+}
+
+void Trace::record(const char *point) noexcept(true) {
+    s_trace_event event = {.time = now(), .point = point, .value = 0.0, .has_value = false};
+    Trace::thread_buffer()->push(event);
+}
+
+void Trace::record(const char *point, double value) noexcept(true) {
+    s_trace_event event = {.time = now(), .point = point, .value = value, .has_value = true};
+    Trace::thread_buffer()->push(event);
+}
+
+void Trace::flush(std::ostream &out) noexcept(true) {
+    struct s_thread_event {
+        s_trace_event event;
+        std::size_t thread_index;
+    };
+    std::vector<s_thread_event> merged;
+    std::uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        std::vector<s_trace_event> events;
+        for (const std::unique_ptr<Buffer> &buffer : registry().buffers) {
+            events.clear();
+            buffer->drain(&events, &dropped);
+            for (const s_trace_event &event : events) {
+                merged.push_back({event, buffer->thread_index()});
+            }
+        }
+    }
+    std::stable_sort(merged.begin(), merged.end(),
+                     [](const s_thread_event &lhs, const s_thread_event &rhs) {
+                         return lhs.event.time < rhs.event.time;
+                     });
+
+    OutputBuffer buffer;
+    for (const s_thread_event &thread_event : merged) {
+        buffer.append(thread_event.event.time);
+        buffer.append(" [thread ");
+        buffer.append(static_cast<std::uint64_t>(thread_event.thread_index));
+        buffer.append("] ");
+        buffer.append(thread_event.event.point);
+        if (thread_event.event.has_value) {
+            buffer.append(Computor::SP);
+            buffer.append(thread_event.event.value);
+        }
+        buffer.append('\n');
+    }
+    if (dropped != 0) {
+        buffer.append("[trace] dropped ");
+        buffer.append(dropped);
+        buffer.append(" events\n");
+    }
+    buffer.write_to(out);
+}
+
+// 初回はBufferを登録し、exit時のflushを1度だけ登録する
+Trace::Buffer *Trace::thread_buffer() noexcept(true) {
+    thread_local Buffer *buffer = nullptr;
+    if (buffer != nullptr) {
+        return buffer;
+    }
+
+    static std::once_flag at_exit;
+    std::call_once(at_exit, [] {
+        registry();
+        std::atexit(Trace::flush_at_exit);
+    });
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    std::vector<std::unique_ptr<Buffer>> &buffers = registry().buffers;
+    buffers.push_back(std::make_unique<Buffer>(buffers.size()));
+    buffer = buffers.back().get();
+    return buffer;
+}
+
+void Trace::flush_at_exit() noexcept(true) {
+    Trace::flush(std::cerr);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+# include <array>
+# include <atomic>
+# include <cstddef>
+# include <cstdint>
+# include <iosfwd>
+# include <vector>
+# include "computor.hpp"
+
+// 診断用のtrace point
+//   COMPUTOR_TRACE_POINT("solve_quadratic() 2-real")
+//   COMPUTOR_TRACE_VALUE("format_solution_type()", type)
+// COMPUTOR_TRACE を定義した場合のみ、thread毎のring buffer (Trace::Buffer) に記録する
+// 定義しない場合は引数も含めて何も生成しない
+// 記録した内容はexit時 (std::atexit) にstderrへ書き、解の途中でstd::coutには書かない
+# ifdef COMPUTOR_TRACE
+#  define COMPUTOR_TRACE_POINT(point) Trace::record(point)
+#  define COMPUTOR_TRACE_VALUE(point, value) Trace::record(point, static_cast<double>(value))
+# else
+#  define COMPUTOR_TRACE_POINT(point) static_cast<void>(0)
+#  define COMPUTOR_TRACE_VALUE(point, value) static_cast<void>(0)
+# endif
+
+// pointは文字列literal (コピーせずpointerのみ保持する)
+struct s_trace_event {
+    std::uint64_t time;     // steady_clockのns
+    const char *point;
+    double value;
+    bool has_value;
+};
+
+// threadは初回のrecord()で自分のBufferを登録し、以降はlockを取らずにBufferへ書く
+// Bufferはthreadの終了後も保持し、flush()でまとめて時刻順に書く
+class Trace {
+ public:
+    static constexpr std::size_t kBufferEvents = Computor::TRACE_BUFFER_EVENTS;
+
+    // 1つのthreadだけが書くring buffer. 満杯なら最も古いeventを上書きする
+    //   head_ : これまでに書いたevent数. 書き込み後にreleaseで進める
+    class Buffer {
+     public:
+        explicit Buffer(std::size_t thread_index);
+        ~Buffer();
+
+        void push(const s_trace_event &event) noexcept(true);
+        void drain(std::vector<s_trace_event> *events, std::uint64_t *dropped) noexcept(true);
+        std::size_t thread_index() const noexcept(true);
+
+     private:
+        std::array<s_trace_event, kBufferEvents> events_;
+        std::atomic<std::uint64_t> head_;
+        std::uint64_t tail_;    // drain済みのevent数 (flushするthreadのみ読み書き)
+        std::size_t thread_index_;
+
+        // copy invalid
+        Buffer &operator=(const Buffer &rhs);
+        Buffer(const Buffer &other);
+    };
+
+    static void record(const char *point) noexcept(true);
+    static void record(const char *point, double value) noexcept(true);
+
+    // 全threadのBufferの未出力のeventを時刻順に書く. 書き込み中のthreadがない時に呼ぶこと
+    //   <time ns> [thread <i>] <point> [value]
+    static void flush(std::ostream &out) noexcept(true);
+
+ private:
+    static Buffer *thread_buffer() noexcept(true);
+    static void flush_at_exit() noexcept(true);
+};
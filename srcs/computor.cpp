@@ -1,34 +1,265 @@
 #include "computor.hpp"
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "Calculator.hpp"
+#include "EquationStream.hpp"
+#include "MappedFile.hpp"
+#include "OutputBuffer.hpp"
+#include "Pipeline.hpp"
+#include "ReorderBuffer.hpp"
+#include "SolutionCache.hpp"
+#include "Stats.hpp"
+#include "ThreadPool.hpp"
 #include "Tokenizer.hpp"
 #include "Result.hpp"
 #include "Parser.hpp"
 
 namespace Computor {
 
-int calc_equation(const std::string &equation) noexcept(true) {
-    Tokenizer tokenizer;
-    Result<Tokens, ErrMsg> tokenize_result = tokenizer.tokenize(equation);
-    if (tokenize_result.is_err()) {
-        std::cerr << "[Error] " << tokenize_result.err_value() << std::endl;
+int calc_equation(
+        std::string_view equation,
+        OutputFormat format,
+        Stats *stats,
+        std::size_t threads) noexcept(true) {
+    s_root_finder_config config;
+    config.threads = threads;
+    Pipeline pipeline;
+    pipeline.set_format(format);
+    pipeline.set_stats(stats);
+    pipeline.set_root_finder_config(config);
+    return pipeline.run(equation, std::cout, std::cerr);
+}
+
+namespace {
+
+// --file, --streamの結果を出力する. JSON, BINARYのrecordのequationは空
+int write_equation_result(
+        const Parser &parser,
+        const Result<Polynomials, ErrMsg> &parse_result,
+        OutputFormat format) noexcept(true) {
+    OutputBuffer out;
+    int result;
+    if (format == TEXT) {
+        if (parse_result.is_err()) {
+            std::cerr << "[Error] " << parse_result.err_value() << std::endl;
+            return EXIT_FAILURE;
+        }
+        result = Pipeline::solve(parser, parse_result.ok_value(), &out);
+    } else if (parse_result.is_err()) {
+        result = Pipeline::error_record("", parse_result.err_value(), format, &out);
+    } else {
+        result = Pipeline::solve_record("", parse_result.ok_value(), format, &out);
+    }
+    out.write_to(std::cout);
+    return result;
+}
+
+}  // namespace
+
+// fileをmmapし、mapした領域をコピーせずにsegmentごとにlex, parseする
+int calc_equation_file(const std::string &path, OutputFormat format) noexcept(true) {
+    MappedFile file;
+    Result<Computor::Status, ErrMsg> open_result = file.open(path);
+    if (open_result.is_err()) {
+        std::cerr << "[Error] " << open_result.err_value() << std::endl;
         return EXIT_FAILURE;
     }
-    Tokens tokens = tokenize_result.ok_value();
 
+    EquationStream stream;
     Parser parser;
-    Result<Polynomials, ErrMsg> parse_result = parser.parse_equation(tokens);
-    if (parse_result.is_err()) {
-        std::cerr << "[Error] " << parse_result.err_value() << std::endl;
+    Result<Polynomials, ErrMsg> parse_result = stream.parse(file.data(), &parser);
+    return write_equation_result(parser, parse_result, format);
+}
+
+// inをchunk_sizeずつ読み、項を多項式へ畳み込む. 入力全体は保持しない
+int calc_equation_stream(
+        std::istream &in,
+        std::size_t chunk_size,
+        OutputFormat format) noexcept(true) {
+    EquationStream stream(chunk_size);
+    Parser parser;
+    Result<Polynomials, ErrMsg> parse_result = stream.parse(in, &parser);
+    return write_equation_result(parser, parse_result, format);
+}
+
+int calc_equation_stream(const std::string &path, OutputFormat format) noexcept(true) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "[Error] cannot open file: " << path << ": "
+                  << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+    return Computor::calc_equation_stream(ifs, STREAM_CHUNK_SIZE, format);
+}
+
+namespace {
+
+// batchの1行分をrecordに追加する. JSON, BINARYではPipelineのrecordのみ
+void append_batch_record(
+        Pipeline *pipeline,
+        std::string_view line,
+        Computor::OutputFormat format,
+        OutputBuffer *record) noexcept(true) {
+    std::string_view equation = Computor::trim_newline(line);
+
+    if (format != Computor::TEXT) {
+        pipeline->run(equation, record, record);
+        return;
+    }
+    record->append("Equation         : ");
+    record->append(equation);
+    record->append('\n');
+    int status = pipeline->run(equation, record, record);
+    record->append("Status           : ");
+    record->append(status);
+    record->append('\n');
+}
+
+// worker毎に持つ状態. Tokenizer, Parser (Pipeline) と出力bufferを他のworkerと共有しない
+struct s_batch_worker {
+    Pipeline pipeline;
+    OutputBuffer record;
+    Stats stats;
+};
+
+// BATCH_CHUNK_LINES行ずつtaskとしてpoolへ渡し、結果はReorderBufferで入力順に並べて書き込む
+// 書き込み待ちのchunkは高々 BATCH_CHUNKS_PER_THREAD * threads 個に抑え、入力全体は保持しない
+void calc_equation_batch_parallel(
+        std::istream &in,
+        std::ostream &out,
+        const Computor::s_batch_options &options,
+        SolutionCache *cache) noexcept(false) {
+    const std::size_t threads = options.threads;
+    std::vector<std::unique_ptr<s_batch_worker>> workers;
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<s_batch_worker>());
+        workers.back()->pipeline.set_solution_cache(cache);
+        workers.back()->pipeline.set_format(options.format);
+        if (options.stats != nullptr) {
+            workers.back()->pipeline.set_stats(&workers.back()->stats);
+        }
+    }
+    ReorderBuffer reorder_buffer;
+    ThreadPool pool(threads);
+    const std::size_t window = Computor::BATCH_CHUNKS_PER_THREAD * threads;
+
+    std::size_t sequence = 0;
+    std::string line;
+    while (in) {
+        std::vector<std::string> lines;
+        lines.reserve(Computor::BATCH_CHUNK_LINES);
+        while (lines.size() < Computor::BATCH_CHUNK_LINES && std::getline(in, line)) {
+            lines.push_back(std::move(line));
+        }
+        if (lines.empty()) {
+            break;
+        }
+
+        if (window <= sequence - reorder_buffer.next_sequence()) {
+            out << reorder_buffer.take();
+        }
+        pool.submit([&workers, &reorder_buffer, &options, sequence, lines = std::move(lines)](
+                std::size_t worker) {
+            s_batch_worker &state = *workers[worker];
+            state.record.clear();
+            for (const std::string &equation : lines) {
+                append_batch_record(&state.pipeline, equation, options.format, &state.record);
+            }
+            reorder_buffer.put(sequence, std::string(state.record.view()));
+        });
+        ++sequence;
+    }
+    while (reorder_buffer.next_sequence() < sequence) {
+        out << reorder_buffer.take();
+    }
+    pool.wait();
+    if (options.stats != nullptr) {
+        for (const std::unique_ptr<s_batch_worker> &worker : workers) {
+            options.stats->merge(worker->stats);
+        }
+    }
+}
+
+}  // namespace
+
+// 1行を1つの方程式として順に解き、行ごとの出力の後にstatus (calc_equation()の戻り値) を出力する
+// 出力はerrorも含めてoutに入力順で書き込む. 戻り値は入力を読めたかどうか
+//   Equation         : 5 * X^0 + 4 * X^1 = 4 * X^0
+//   Reduced form     : 4 * X + 1 = 0
+//   ...
+//   Status           : 0
+// threads > 1 の場合はworker毎にPipelineを持つthread poolで解き、出力順は入力順のまま
+// cache_capacity > 0 の場合は全workerで1つのSolutionCacheを共有する
+// format が JSON, BINARY の場合は1行につき1record (Equation, Statusの行はない)
+int calc_equation_batch(
+        std::istream &in,
+        std::ostream &out,
+        const s_batch_options &options) noexcept(true) {
+    std::unique_ptr<SolutionCache> cache;
+    if (0 < options.cache_capacity) {
+        cache = std::make_unique<SolutionCache>(options.cache_capacity);
+    }
+
+    if (options.threads <= 1) {
+        Pipeline pipeline;
+        pipeline.set_solution_cache(cache.get());
+        pipeline.set_format(options.format);
+        pipeline.set_stats(options.stats);
+        std::string line;
+        OutputBuffer record;
+        std::size_t record_lines = 0;
+
+        // BATCH_CHUNK_LINES行ごとに1回書き込む
+        while (std::getline(in, line)) {
+            append_batch_record(&pipeline, line, options.format, &record);
+            if (++record_lines == Computor::BATCH_CHUNK_LINES) {
+                record.write_to(out);
+                record_lines = 0;
+            }
+        }
+        record.write_to(out);
+    } else {
+        try {
+            calc_equation_batch_parallel(in, out, options, cache.get());
+        } catch (const std::exception &e) {
+            std::cerr << "[Error] " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    out.flush();
+    if (in.bad()) {
+        std::cerr << "[Error] cannot read input" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int calc_equation_batch(const std::string &path, const s_batch_options &options) noexcept(true) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "[Error] cannot open file: " << path << ": "
+                  << std::strerror(errno) << std::endl;
         return EXIT_FAILURE;
     }
-    parser.display_reduced_form();
-    parser.display_polynomial_degree();
-    Polynomials polynomial = parse_result.ok_value();
+    return Computor::calc_equation_batch(ifs, std::cout, options);
+}
 
-    Calculator calculator(polynomial);
-    return calculator.solve_quadratic_equation();
+// 末尾の改行 (LF, CRLF) を除く
+std::string_view trim_newline(std::string_view equation) noexcept(true) {
+    while (!equation.empty() && (equation.back() == '\n' || equation.back() == '\r')) {
+        equation.remove_suffix(1);
+    }
+    return equation;
 }
 
 double normalize_zero(double value) noexcept(true) {
@@ -46,20 +277,45 @@ double sqrt(double num) noexcept(false) {
     if (num < 0) {
         throw std::domain_error("Cannot calculate square root of negative number");
     }
-    if (num == 0 || num == 1) { return num; }
+    return Computor::try_sqrt(num).second;
+}
+
+// 例外を投げないsqrt. num が nan, inf, 負数 の場合はFAILURE
+// 初期値を指数部から求め、固定回数 (SQRT_NEWTON_STEPS) のNewton法で収束させる
+//   bit列を1bit右shiftすると指数部が半分になり、sqrt(num)の相対誤差6%以内の近似値が得られる
+//   Newton法1回で相対誤差はおよそ2乗になるため、4回で倍精度に達する
+// COMPUTOR_HARDWARE_SQRT を定義した場合はsqrt命令を使う
+std::pair<Status, double> try_sqrt(double num) noexcept(true) {
+    std::pair<Status, double> result;
+    result.first = FAILURE;
+
+    if (Computor::isnan(num) || Computor::isinf(num) || num < 0) {
+        return result;
+    }
+    result.first = SUCCESS;
+    if (num == 0 || num == 1) {
+        result.second = num;
+        return result;
+    }
 
-    double epsilon = 1e-15;
-    double guess = (num < 1.0) ? 1.0 : num / 2.0;
+#ifdef COMPUTOR_HARDWARE_SQRT
+    result.second = std::sqrt(num);
+#else
+    // subnormalは指数部から初期値を求められないため、2^54倍してから求め2^-27倍する
+    constexpr double kScaleUp = 18014398509481984.0;           // 2^54
+    constexpr double kScaleDown = 1.0 / 134217728.0;            // 2^-27
+    bool is_subnormal = num < std::numeric_limits<double>::min();
+    double x = is_subnormal ? num * kScaleUp : num;
 
-    int max_iterations = 1000;
-    for (int i = 0; i < max_iterations; ++i) {
-        double difference = guess * guess - num;
-        if (Computor::abs(difference) < epsilon * num) {
-            break;
-        }
-        guess = (guess + num / guess) / 2.0;
+    constexpr std::uint64_t kExponentBias = 0x1FF8000000000000;  // (1023 << 52) / 2
+    std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+    double guess = std::bit_cast<double>((bits >> 1) + kExponentBias);
+    for (int i = 0; i < SQRT_NEWTON_STEPS; ++i) {
+        guess = 0.5 * (guess + x / guess);
     }
-    return guess;
+    result.second = is_subnormal ? guess * kScaleDown : guess;
+#endif
+    return result;
 }
 
 bool isnan(double num) noexcept(true) {
@@ -71,4 +327,49 @@ bool isinf(double num) noexcept(true) {
         || num == -std::numeric_limits<double>::infinity();
 }
 
+// word = integer / decimal (Tokenizerで検証済み)
+// 例外を使わずに変換する. 範囲外 (overflow, 0以外の値のunderflow, subnormal) はFAILURE
+std::pair<Status, double> stod(std::string_view word) noexcept(true) {
+    std::pair<Status, double> result;
+    result.first = FAILURE;
+
+    // from_charsは先頭の'-'を受け付けるため、先頭はdigitに限る
+    if (word.empty() || !std::isdigit(static_cast<unsigned char>(word[0]))) {
+        return result;
+    }
+    const char *end = word.data() + word.length();
+    double dnum;
+    std::from_chars_result conv = std::from_chars(
+            word.data(), end, dnum, std::chars_format::fixed);
+    if (conv.ec != std::errc() || conv.ptr != end) {
+        return result;
+    }
+    // from_charsはsubnormalを範囲内として返す. std::stod (strtod) と同じく範囲外とする
+    if (dnum != 0.0 && dnum < std::numeric_limits<double>::min()) {
+        return result;
+    }
+    result.first = SUCCESS;
+    result.second = dnum;
+    return result;
+}
+
+// word = integer (Tokenizerで検証済み). 0 <= num <= INT32_MAX
+std::pair<Status, std::int32_t> stoi(std::string_view word) noexcept(true) {
+    std::pair<Status, std::int32_t> result;
+    result.first = FAILURE;
+
+    if (word.empty() || !std::isdigit(static_cast<unsigned char>(word[0]))) {
+        return result;
+    }
+    const char *end = word.data() + word.length();
+    std::int32_t num;
+    std::from_chars_result conv = std::from_chars(word.data(), end, num);
+    if (conv.ec != std::errc() || conv.ptr != end) {
+        return result;
+    }
+    result.first = SUCCESS;
+    result.second = num;
+    return result;
+}
+
 }  // namespace Computor
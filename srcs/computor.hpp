@@ -1,9 +1,16 @@
 #pragma once
 
+# include <cstddef>
+# include <cstdint>
+# include <iosfwd>
 # include <string>
+# include <string_view>
+# include <utility>
 
 using ErrMsg = std::string;
 
+class Stats;
+
 namespace Computor {
 
 enum Status {
@@ -11,6 +18,15 @@ enum Status {
     FAILURE = 0,
 };
 
+// TEXT   : "Reduced form     : ..." (人間向け)
+// JSON   : 1方程式1行のJSON
+// BINARY : 固定layoutのlittle-endian record (RecordFormatter.hpp)
+enum OutputFormat {
+    TEXT,
+    JSON,
+    BINARY,
+};
+
 constexpr char SP       = ' ';
 constexpr char OP_PLUS  = '+';
 constexpr char OP_MINUS = '-';
@@ -18,11 +34,57 @@ constexpr char OP_MUL   = '*';
 constexpr char OP_EQUAL = '=';
 constexpr char OP_POW   = '^';
 
-int calc_equation(const std::string &equation) noexcept(true);
+constexpr std::size_t STREAM_CHUNK_SIZE = 64 * 1024;
+constexpr std::size_t BATCH_CHUNK_LINES = 256;
+constexpr std::size_t BATCH_CHUNKS_PER_THREAD = 4;
+constexpr std::size_t BATCH_MAX_THREADS = 256;
+constexpr int SQRT_NEWTON_STEPS = 4;
+constexpr std::int32_t POLYNOMIAL_MAX_DEGREE = 16384;     // Aberth法の1 sweepはO(n^2)
+constexpr double ROOT_FINDER_TOLERANCE = 1e-12;
+constexpr std::int32_t ROOT_FINDER_MAX_ITERATIONS = 1000;
+constexpr std::size_t ROOT_FINDER_BLOCK_ROOTS = 256;
+constexpr std::size_t ROOT_FINDER_PARALLEL_MIN_DEGREE = 512;
+constexpr std::size_t SOLUTION_CACHE_SHARDS = 16;
+constexpr std::size_t TRACE_BUFFER_EVENTS = 1024;
+constexpr std::size_t ARENA_BUFFER_BYTES = 8 * 1024;
+
+// threads        : 2以上の場合、worker毎にPipelineを持つthread poolで解く
+// cache_capacity : 0より大きい場合、全workerで共有するSolutionCacheの容量
+// stats          : nullptrでなければ全workerのstage毎の統計を加える (所有しない)
+struct s_batch_options {
+    std::size_t threads = 1;
+    std::size_t cache_capacity = 0;
+    OutputFormat format = TEXT;
+    Stats *stats = nullptr;
+};
+
+// threads : RootFinderのthread数 (次数がROOT_FINDER_PARALLEL_MIN_DEGREE以上の場合に並列に解く)
+int calc_equation(
+        std::string_view equation,
+        OutputFormat format = TEXT,
+        Stats *stats = nullptr,
+        std::size_t threads = 1) noexcept(true);
+int calc_equation_file(const std::string &path, OutputFormat format = TEXT) noexcept(true);
+int calc_equation_stream(
+        std::istream &in,
+        std::size_t chunk_size = STREAM_CHUNK_SIZE,
+        OutputFormat format = TEXT) noexcept(true);
+int calc_equation_stream(const std::string &path, OutputFormat format = TEXT) noexcept(true);
+int calc_equation_batch(
+        std::istream &in,
+        std::ostream &out,
+        const s_batch_options &options = s_batch_options()) noexcept(true);
+int calc_equation_batch(
+        const std::string &path,
+        const s_batch_options &options = s_batch_options()) noexcept(true);
+std::string_view trim_newline(std::string_view equation) noexcept(true);
 double normalize_zero(double value) noexcept(true);
 double abs(double num) noexcept(true);
 double sqrt(double num) noexcept(false);
+std::pair<Status, double> try_sqrt(double num) noexcept(true);
 bool isnan(double num) noexcept(true);
 bool isinf(double num) noexcept(true);
+std::pair<Status, double> stod(std::string_view word) noexcept(true);
+std::pair<Status, std::int32_t> stoi(std::string_view word) noexcept(true);
 
 }  // namespace Computor
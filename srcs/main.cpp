@@ -1,13 +1,172 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
 #include "computor.hpp"
+#include "OutputBuffer.hpp"
+#include "Stats.hpp"
+
+// text, json, binary
+static bool parse_format(const std::string &word, Computor::OutputFormat *format) {
+    if (word == "text") {
+        *format = Computor::TEXT;
+    } else if (word == "json") {
+        *format = Computor::JSON;
+    } else if (word == "binary") {
+        *format = Computor::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 1 <= N <= BATCH_MAX_THREADS
+static bool parse_threads(const std::string &word, std::size_t *threads) {
+    std::pair<Computor::Status, std::int32_t> number = Computor::stoi(word);
+    if (number.first == Computor::Status::FAILURE
+        || number.second < 1
+        || Computor::BATCH_MAX_THREADS < static_cast<std::size_t>(number.second)) {
+        return false;
+    }
+    *threads = static_cast<std::size_t>(number.second);
+    return true;
+}
+
+// <equation>のRootFinderの既定のthread数. 次数が低い方程式はthreadを作らない
+static std::size_t default_threads() {
+    std::size_t threads = std::thread::hardware_concurrency();
+    return std::clamp<std::size_t>(threads, 1, Computor::BATCH_MAX_THREADS);
+}
+
+// --batch [--threads N] [--cache N] [path]
+static int calc_batch(int argc, char **argv, Computor::OutputFormat format, Stats *stats) {
+    Computor::s_batch_options options;
+    options.format = format;
+    options.stats = stats;
+    const char *path = nullptr;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            if (!parse_threads(argv[++i], &options.threads)) {
+                std::cerr << "[Error] invalid number of threads: " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if (std::string(argv[i]) == "--cache" && i + 1 < argc) {
+            std::pair<Computor::Status, std::int32_t> number = Computor::stoi(argv[++i]);
+            if (number.first == Computor::Status::FAILURE || number.second < 1) {
+                std::cerr << "[Error] invalid cache capacity: " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+            options.cache_capacity = static_cast<std::size_t>(number.second);
+        } else if (path == nullptr) {
+            path = argv[i];
+        } else {
+            std::cerr << "[Error] invalid argument: " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (path == nullptr) {
+        return Computor::calc_equation_batch(std::cin, std::cout, options);
+    }
+    return Computor::calc_equation_batch(std::string(path), options);
+}
+
+// equation, --batchを解き、statsがあればstderrに書く
+static int calc_with_stats(
+        int argc,
+        char **argv,
+        Computor::OutputFormat format,
+        Computor::OutputFormat stats_format,
+        std::size_t threads) {
+    if (!Stats::kEnabled) {
+        std::cerr << "[Error] --stats is not available: built without COMPUTOR_STATS" << std::endl;
+        return EXIT_FAILURE;
+    }
+    Stats stats;
+    int result;
+    if (2 <= argc && std::string(argv[1]) == "--batch") {
+        result = calc_batch(argc, argv, format, &stats);
+    } else if (argc == 2 && std::string(argv[1]) != "--stream") {
+        result = Computor::calc_equation(argv[1], format, &stats, threads);
+    } else {
+        std::cerr << "[Error] --stats is supported with <equation> and --batch only" << std::endl;
+        return EXIT_FAILURE;
+    }
+    OutputBuffer out;
+    stats.format(stats_format, &out);
+    out.write_to(std::cerr);
+    return result;
+}
 
 int main(int argc, char **argv) {
+    // --format F, --stats F, --threads N を除いた残りの引数で各modeを選ぶ
+    // --threads N は<equation>のRootFinderのthread数 (--batchでは--batchの後に指定する)
+    Computor::OutputFormat format = Computor::TEXT;
+    Computor::OutputFormat stats_format = Computor::TEXT;
+    bool has_stats = false;
+    std::size_t threads = default_threads();
+    bool has_threads = false;
+    while (3 <= argc && (std::string(argv[1]) == "--format" || std::string(argv[1]) == "--stats"
+                         || std::string(argv[1]) == "--threads")) {
+        if (std::string(argv[1]) == "--threads") {
+            if (!parse_threads(argv[2], &threads)) {
+                std::cerr << "[Error] invalid number of threads: " << argv[2] << std::endl;
+                return EXIT_FAILURE;
+            }
+            has_threads = true;
+            argc -= 2;
+            argv += 2;
+            continue;
+        }
+        bool is_stats = (std::string(argv[1]) == "--stats");
+        Computor::OutputFormat *target = is_stats ? &stats_format : &format;
+        if (!parse_format(argv[2], target) || (is_stats && *target == Computor::BINARY)) {
+            std::cerr << "[Error] invalid format: " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+        has_stats |= is_stats;
+        argc -= 2;
+        argv += 2;
+    }
+    if (has_threads && 2 <= argc && std::string(argv[1]).starts_with("--")) {
+        std::cerr << "[Error] --threads is supported with <equation> only"
+                     " (use --batch --threads N)" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (has_stats) {
+        return calc_with_stats(argc, argv, format, stats_format, threads);
+    }
+
+    if (argc == 3 && std::string(argv[1]) == "--file") {
+        return Computor::calc_equation_file(argv[2], format);
+    }
+    if (2 <= argc && argc <= 3 && std::string(argv[1]) == "--stream") {
+        if (argc == 2) {
+            return Computor::calc_equation_stream(std::cin, Computor::STREAM_CHUNK_SIZE, format);
+        }
+        return Computor::calc_equation_stream(std::string(argv[2]), format);
+    }
+    if (2 <= argc && std::string(argv[1]) == "--batch") {
+        return calc_batch(argc, argv, format, nullptr);
+    }
     if (argc != 2) {
         std::cout << "[Error] invalid argument.\n"
-                     "        Expected: $> ./computor <equation>" << std::endl;
+                     "        Expected: $> ./computor [--format F] [--stats S] [--threads N]"
+                     " <equation>\n"
+                     "                  $> ./computor [--format F] --file <path>\n"
+                     "                  $> ./computor [--format F] --stream [path]\n"
+                     "                  $> ./computor [--format F] [--stats S] --batch"
+                     " [--threads N] [--cache N] [path]\n"
+                     "                  F: text, json, binary\n"
+                     "                  S: text, json (stage stats to stderr)\n"
+                     "                  N: threads (<equation>: root finder, default: all cores)"
+                  << std::endl;
         return EXIT_FAILURE;
     }
     // std::cout << "arg: [" << argv[1] << "]" << std::endl;
     std::string equation = argv[1];
-    return Computor::calc_equation(equation);
+    return Computor::calc_equation(equation, format, nullptr, threads);
 }
@@ -0,0 +1,10 @@
+#include "BenchAllocation.hpp"
+
+void set_allocation_counter(
+        benchmark::State &state,
+        const AllocationCounter &counter,
+        std::uint64_t equations) {
+    double count = static_cast<double>(counter.counts().allocations);
+    double total = static_cast<double>(state.iterations()) * static_cast<double>(equations);
+    state.counters["allocs"] = total == 0.0 ? 0.0 : count / total;
+}
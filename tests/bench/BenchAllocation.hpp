@@ -0,0 +1,12 @@
+#pragma once
+
+# include <cstdint>
+# include "AllocationCounter.hpp"
+# include "benchmark/benchmark.h"
+
+// counterの構築からのheapの確保数を、1方程式当たりの値 (state.iterations() * equations で割る) として
+// state.counters["allocs"] に記録する. 数えるのはbenchのthreadのみ (AllocationCounter)
+void set_allocation_counter(
+        benchmark::State &state,
+        const AllocationCounter &counter,
+        std::uint64_t equations = 1);
@@ -0,0 +1,100 @@
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "BenchEquation.hpp"
+#include "computor.hpp"
+#include "benchmark/benchmark.h"
+
+
+// 1行1方程式 (次数0〜2, 係数は整数/小数) をline_count行生成 (seed固定)
+static std::string make_batch(std::size_t line_count) {
+    std::mt19937 engine(42);
+    std::string batch;
+
+    for (std::size_t i = 0; i < line_count; ++i) {
+        std::size_t term_count = 1 + engine() % 4;
+        for (std::size_t j = 0; j < term_count; ++j) {
+            if (j != 0) {
+                batch += (engine() % 2) ? " + " : " - ";
+            }
+            batch += std::to_string(engine() % 100);
+            if (engine() % 2) {
+                batch += "." + std::to_string(engine() % 100);
+            }
+            batch += " * X^" + std::to_string(engine() % 3);
+        }
+        batch += " = " + std::to_string(engine() % 10) + "\n";
+    }
+    return batch;
+}
+
+// 100万方程式の--batchを1〜64threadで解く
+static void BM_BatchThreads(benchmark::State &state) {
+    static const std::string batch = make_batch(1000000);
+    std::size_t threads = static_cast<std::size_t>(state.range(0));
+    NullBuffer null_buffer;
+    std::ostream out(&null_buffer);
+
+    for (auto _ : state) {
+        std::istringstream in(batch);
+        benchmark::DoNotOptimize(Computor::calc_equation_batch(in, out, {.threads = threads}));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 1000000));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * batch.size()));
+}
+BENCHMARK(BM_BatchThreads)
+        ->RangeMultiplier(2)->Range(1, 64)
+        ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(1);
+
+
+// 100種類の6次方程式 (係数は整数, seed固定) を繰り返す10万行の--batchを、
+// cacheの容量を変えて解く (0はcacheなし). 100未満の容量ではLRUが毎回外れる
+static void BM_BatchCache(benchmark::State &state) {
+    static const std::string batch = [] {
+        std::mt19937 engine(42);
+        std::string equations;
+        for (int i = 0; i < 100; ++i) {
+            for (int degree = 6; 0 <= degree; --degree) {
+                equations += std::to_string(1 + engine() % 9) + " * X^" + std::to_string(degree);
+                equations += (degree == 0) ? " = 0\n" : " + ";
+            }
+        }
+        std::string repeated;
+        for (int i = 0; i < 1000; ++i) {
+            repeated += equations;
+        }
+        return repeated;
+    }();
+    std::size_t capacity = static_cast<std::size_t>(state.range(0));
+    NullBuffer null_buffer;
+    std::ostream out(&null_buffer);
+
+    for (auto _ : state) {
+        std::istringstream in(batch);
+        Computor::s_batch_options options = {.cache_capacity = capacity};
+        benchmark::DoNotOptimize(Computor::calc_equation_batch(in, out, options));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 100000));
+}
+BENCHMARK(BM_BatchCache)
+        ->Arg(0)->Arg(64)->Arg(1024)
+        ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(1);
+
+
+// 100万方程式の--batchを --format text / json / binary (0 / 1 / 2) で出力する
+static void BM_BatchFormat(benchmark::State &state) {
+    static const std::string batch = make_batch(1000000);
+    Computor::OutputFormat format = static_cast<Computor::OutputFormat>(state.range(0));
+    NullBuffer null_buffer;
+    std::ostream out(&null_buffer);
+
+    for (auto _ : state) {
+        std::istringstream in(batch);
+        benchmark::DoNotOptimize(Computor::calc_equation_batch(in, out, {.format = format}));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 1000000));
+}
+BENCHMARK(BM_BatchFormat)
+        ->DenseRange(Computor::TEXT, Computor::BINARY)
+        ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(1);
@@ -0,0 +1,155 @@
+#include <ostream>
+#include <random>
+#include <vector>
+#include "Arena.hpp"
+#include "BenchAllocation.hpp"
+#include "BenchEquation.hpp"
+#include "Calculator.hpp"
+#include "OutputBuffer.hpp"
+#include "RootFinder.hpp"
+#include "benchmark/benchmark.h"
+
+
+// size組の (a, b, c) をbatchで解く (seed固定)
+static void BM_SolveQuadraticBatch(benchmark::State &state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    QuadraticSolver::BatchIsa isa = static_cast<QuadraticSolver::BatchIsa>(state.range(1));
+    if (isa != QuadraticSolver::Scalar && Calculator::detect_batch_isa() < isa) {
+        state.SkipWithError("isa is not supported");
+        return;
+    }
+
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-100.0, 100.0);
+    std::vector<double> a(size), b(size), c(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        a[i] = real(engine);
+        b[i] = real(engine);
+        c[i] = real(engine);
+    }
+    std::vector<QuadraticSolver::SolutionType> types(size);
+    std::vector<double> re1(size), im1(size), re2(size), im2(size);
+
+    for (auto _ : state) {
+        Calculator::solve_quadratic_batch(
+                {a.data(), b.data(), c.data()},
+                {types.data(), re1.data(), im1.data(), re2.data(), im2.data()},
+                size,
+                isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_SolveQuadraticBatch)
+        ->ArgsProduct({{1 << 10, 1 << 20},
+                       {QuadraticSolver::Scalar, QuadraticSolver::Avx2, QuadraticSolver::Avx512}});
+
+
+// 次数degreeの多項式 (係数は[-1, 1), seed固定) の全ての根をAberth-Ehrlich法で求める
+static void BM_RootFinder(benchmark::State &state) {
+    std::size_t degree = static_cast<std::size_t>(state.range(0));
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    std::vector<double> coefficients;
+    for (std::size_t i = 0; i <= degree; ++i) {
+        coefficients.push_back(real(engine));
+    }
+    RootFinder root_finder;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root_finder.solve(coefficients));
+    }
+    state.counters["iterations"] = root_finder.iterations();
+}
+BENCHMARK(BM_RootFinder)->Arg(3)->Arg(4)->Arg(10)->Arg(50)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+
+// 次数degreeの多項式の根をthreads個のthreadで求める (threads == 1 は逐次, seed固定)
+static void BM_RootFinderParallel(benchmark::State &state) {
+    std::size_t degree = static_cast<std::size_t>(state.range(0));
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    std::vector<double> coefficients;
+    for (std::size_t i = 0; i <= degree; ++i) {
+        coefficients.push_back(real(engine));
+    }
+    s_root_finder_config config;
+    config.threads = static_cast<std::size_t>(state.range(1));
+    RootFinder root_finder(config);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root_finder.solve(coefficients));
+    }
+    state.counters["iterations"] = root_finder.iterations();
+}
+BENCHMARK(BM_RootFinderParallel)
+        ->ArgsProduct({{1000, 10000}, {1, 2, 4, 8}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+
+// 次数degreeの方程式1つをCalculatorで解く (係数は[-1, 1), seed固定, 出力は捨てる)
+// degree 3, 4は解の公式、5以上はAberth-Ehrlich法. BM_RootFinderと比較する
+// 途中の値はArenaから確保し、1回毎にrelease()する. 1方程式当たりの
+//   allocs      : heapの確保数
+//   arena_allocs: arenaへの確保要求の数
+static void BM_SolveEquation(benchmark::State &state) {
+    std::int32_t degree = static_cast<std::int32_t>(state.range(0));
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    Polynomials polynomial;
+    for (std::int32_t i = 0; i <= degree; ++i) {
+        polynomial[i] = real(engine);
+    }
+    std::ostream null_out(nullptr);
+    Arena arena;
+    Calculator calculator(&arena);
+    AllocationCounter allocations;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.solve_quadratic_equation(polynomial, null_out));
+        arena.release();
+    }
+    set_allocation_counter(state, allocations);
+    state.counters["arena_allocs"] = static_cast<double>(arena.counts().allocations)
+                                     / static_cast<double>(arena.counts().releases);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SolveEquation)->DenseRange(2, 5)->Unit(benchmark::kMicrosecond);
+
+
+// count個の2次方程式 (seed固定) を1つのCalculatorのsolve_quadratic_equation()で順に解き、
+// OutputBufferに書式化する
+// 係数は整数 (-100〜100) / 小数 (小数部3桁)
+static void BM_SolveQuadraticEquation(benchmark::State &state) {
+    std::size_t count = static_cast<std::size_t>(state.range(0));
+    CoefficientFormat format = static_cast<CoefficientFormat>(state.range(1));
+    std::mt19937 engine(42);
+    auto coefficient = [&engine, format]() {
+        double num = static_cast<double>(engine() % 201) - 100.0;
+        if (format == DecimalCoefficient) {
+            num += static_cast<double>(engine() % 1000) / 1000.0;
+        }
+        return num == 0.0 ? 1.0 : num;
+    };
+    std::vector<Polynomials> polynomials(count);
+    for (Polynomials &polynomial : polynomials) {
+        polynomial[2] = coefficient();
+        polynomial[1] = coefficient();
+        polynomial[0] = coefficient();
+    }
+    OutputBuffer out;
+    Calculator calculator;
+
+    for (auto _ : state) {
+        for (const Polynomials &polynomial : polynomials) {
+            benchmark::DoNotOptimize(calculator.solve_quadratic_equation(polynomial, &out));
+            out.clear();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_SolveQuadraticEquation)
+        ->ArgsProduct({benchmark::CreateRange(10, 1000000, 10),
+                       {IntegerCoefficient, DecimalCoefficient}})
+        ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchAllocation.hpp"
+#include "BenchEquation.hpp"
+#include "computor.hpp"
+#include "OutputBuffer.hpp"
+#include "Pipeline.hpp"
+#include "benchmark/benchmark.h"
+
+
+// CLIと同じcalc_equation() (parse -> 表示 -> 求解). 係数は整数/小数, std::coutの出力は捨てる
+// allocs: 1方程式当たりのheapの確保数 (方程式毎のPipelineの構築を含む)
+static void BM_CalcEquation(benchmark::State &state) {
+    std::string equation = make_equation(
+            static_cast<std::size_t>(state.range(0)),
+            static_cast<CoefficientFormat>(state.range(1)));
+    NullBuffer null_buffer;
+    std::streambuf *cout_buffer = std::cout.rdbuf(&null_buffer);
+    AllocationCounter allocations;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Computor::calc_equation(equation));
+    }
+    set_allocation_counter(state, allocations);
+    std::cout.rdbuf(cout_buffer);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_CalcEquation)
+        ->ArgsProduct({benchmark::CreateRange(10, 10000000, 10),
+                       {IntegerCoefficient, DecimalCoefficient}})
+        ->Unit(benchmark::kMicrosecond);
+
+
+// 1つのPipelineで次数degreeの方程式 "X^degree - 2 * X + 1 = 0" を繰り返し解く (--batchと同じ再利用)
+// 1方程式当たりの
+//   allocs      : heapの確保数 (arenaに収まる次数では0)
+//   arena_allocs: arenaへの確保要求の数
+//   arena_bytes : arenaへの確保要求のbyte数
+//   arena_heap  : arenaのbufferに収まらずheapから確保した数
+static void BM_PipelineEquation(benchmark::State &state) {
+    std::string equation = "X^" + std::to_string(state.range(0)) + " - 2 * X + 1 = 0";
+    Pipeline pipeline;
+    OutputBuffer out;
+    pipeline.run(equation, &out, &out);
+    out.clear();
+    s_arena_counts arena_begin = pipeline.arena_counts();
+    AllocationCounter allocations;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pipeline.run(equation, &out, &out));
+        out.clear();
+    }
+    set_allocation_counter(state, allocations);
+    const s_arena_counts &arena = pipeline.arena_counts();
+    double equations = static_cast<double>(arena.releases - arena_begin.releases);
+    state.counters["arena_allocs"] =
+            static_cast<double>(arena.allocations - arena_begin.allocations) / equations;
+    state.counters["arena_bytes"] =
+            static_cast<double>(arena.bytes - arena_begin.bytes) / equations;
+    state.counters["arena_heap"] =
+            static_cast<double>(arena.upstream_allocations - arena_begin.upstream_allocations)
+            / equations;
+}
+BENCHMARK(BM_PipelineEquation)->Arg(1)->Arg(2)->Arg(3)->Arg(4)->Arg(8)->Arg(32)->Arg(512)
+        ->Unit(benchmark::kMicrosecond);
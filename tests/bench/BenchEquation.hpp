@@ -0,0 +1,39 @@
+#pragma once
+
+# include <cstdint>
+# include <random>
+# include <streambuf>
+# include <string>
+
+// make_equation()の係数の表記
+enum CoefficientFormat : std::int64_t {
+    IntegerCoefficient = 0,     // "123"
+    DecimalCoefficient = 1,     // "123.456"
+};
+
+// " + 12.345 * X^2 - 7X + ..." をterm_count項生成 (seed固定)
+inline std::string make_equation(
+        std::size_t term_count,
+        CoefficientFormat format = DecimalCoefficient) {
+    std::mt19937 engine(42);
+    std::string equation;
+
+    for (std::size_t i = 0; i < term_count; ++i) {
+        equation += (engine() % 2) ? " + " : " - ";
+        equation += std::to_string(engine() % 1000);
+        if (format == DecimalCoefficient) {
+            equation += "." + std::to_string(engine() % 1000);
+        }
+        equation += (engine() % 2) ? " * X^" : "X^";
+        equation += std::to_string(engine() % 3);
+    }
+    equation += " = 0";
+    return equation;
+}
+
+// 出力を捨てるstream buffer
+class NullBuffer : public std::streambuf {
+ protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
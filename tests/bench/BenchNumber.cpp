@@ -0,0 +1,254 @@
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchEquation.hpp"
+#include "computor.hpp"
+#include "OutputBuffer.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// 仮数部の長い係数をcount個生成 (seed固定)
+//   "123456.789012345678", ...
+std::vector<std::string> make_coefficients(std::size_t count, std::size_t digits) {
+    std::mt19937 engine(42);
+    std::vector<std::string> words;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string word;
+        for (std::size_t j = 0; j < digits; ++j) {
+            word += static_cast<char>('0' + engine() % 10);
+        }
+        word.insert(1 + engine() % (digits - 1), ".");
+        words.push_back(word);
+    }
+    return words;
+}
+
+// 範囲外の係数. 1E+309, 1E-308
+std::vector<std::string> make_out_of_range(std::size_t count) {
+    std::vector<std::string> words;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            words.push_back("1" + std::string(309, '0'));
+        } else {
+            words.push_back("0." + std::string(307, '0') + "1");
+        }
+    }
+    return words;
+}
+
+// 置き換え前のstd::stod + try/catchによる実装. 比較用
+std::pair<Computor::Status, double> stod_by_exception(std::string_view word) {
+    std::pair<Computor::Status, double> result;
+    result.first = Computor::FAILURE;
+
+    if (word.empty() || !std::isdigit(word[0])) {
+        return result;
+    }
+    try {
+        std::size_t end;
+        double dnum = std::stod(std::string(word), &end);
+        if (end < word.length()) {
+            return result;
+        }
+        result.first = Computor::SUCCESS;
+        result.second = dnum;
+        return result;
+    } catch (const std::exception &e) {
+        return result;
+    }
+}
+
+// 置き換え前のsqrt (num / 2から収束するまでNewton法). 比較用
+double sqrt_from_half(double num) {
+    if (num == 0 || num == 1) { return num; }
+
+    double epsilon = 1e-15;
+    double guess = (num < 1.0) ? 1.0 : num / 2.0;
+    for (int i = 0; i < 1000; ++i) {
+        double difference = guess * guess - num;
+        if (Computor::abs(difference) < epsilon * num) {
+            break;
+        }
+        guess = (guess + num / guess) / 2.0;
+    }
+    return guess;
+}
+
+// 判別式の絶対値として現れる値. 1e-300 〜 DBL_MAX (seed固定)
+std::vector<double> make_sqrt_inputs(std::size_t count) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> exponent(-300.0, 308.0);
+    std::vector<double> nums;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        nums.push_back(std::pow(10.0, exponent(engine)));
+    }
+    return nums;
+}
+
+// 係数 (整数 -100〜100 / 小数部3桁) から求めた判別式の絶対値 |b^2 - 4ac| をcount個 (seed固定)
+std::vector<double> make_discriminants(std::size_t count, CoefficientFormat format) {
+    std::mt19937 engine(42);
+    auto coefficient = [&engine, format]() {
+        double num = static_cast<double>(engine() % 201) - 100.0;
+        if (format == DecimalCoefficient) {
+            num += static_cast<double>(engine() % 1000) / 1000.0;
+        }
+        return num;
+    };
+    std::vector<double> nums;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        double a = coefficient();
+        double b = coefficient();
+        double c = coefficient();
+        nums.push_back(std::abs(b * b - 4.0 * a * c));
+    }
+    return nums;
+}
+
+}  // namespace
+
+
+static void BM_StodByException(benchmark::State &state) {
+    std::vector<std::string> words = make_coefficients(4096, state.range(0));
+
+    for (auto _ : state) {
+        for (const auto &word : words) {
+            benchmark::DoNotOptimize(stod_by_exception(word));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK(BM_StodByException)->Arg(8)->Arg(18)->Arg(40);
+
+
+static void BM_Stod(benchmark::State &state) {
+    std::vector<std::string> words = make_coefficients(4096, state.range(0));
+
+    for (auto _ : state) {
+        for (const auto &word : words) {
+            benchmark::DoNotOptimize(Computor::stod(word));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK(BM_Stod)->Arg(8)->Arg(18)->Arg(40);
+
+
+static void BM_StodOutOfRangeByException(benchmark::State &state) {
+    std::vector<std::string> words = make_out_of_range(256);
+
+    for (auto _ : state) {
+        for (const auto &word : words) {
+            benchmark::DoNotOptimize(stod_by_exception(word));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK(BM_StodOutOfRangeByException);
+
+
+static void BM_StodOutOfRange(benchmark::State &state) {
+    std::vector<std::string> words = make_out_of_range(256);
+
+    for (auto _ : state) {
+        for (const auto &word : words) {
+            benchmark::DoNotOptimize(Computor::stod(word));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK(BM_StodOutOfRange);
+
+
+static void BM_SqrtFromHalf(benchmark::State &state) {
+    std::vector<double> nums = make_sqrt_inputs(4096);
+
+    for (auto _ : state) {
+        for (double num : nums) {
+            benchmark::DoNotOptimize(sqrt_from_half(num));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nums.size()));
+}
+BENCHMARK(BM_SqrtFromHalf);
+
+
+static void BM_Sqrt(benchmark::State &state) {
+    std::vector<double> nums = make_sqrt_inputs(4096);
+
+    for (auto _ : state) {
+        for (double num : nums) {
+            benchmark::DoNotOptimize(Computor::sqrt(num));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nums.size()));
+}
+BENCHMARK(BM_Sqrt);
+
+
+// 2次方程式の判別式として現れる値のsqrt. count個, 係数は整数/小数
+static void BM_SqrtDiscriminant(benchmark::State &state) {
+    std::vector<double> nums = make_discriminants(
+            static_cast<std::size_t>(state.range(0)),
+            static_cast<CoefficientFormat>(state.range(1)));
+
+    for (auto _ : state) {
+        for (double num : nums) {
+            benchmark::DoNotOptimize(Computor::sqrt(num));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nums.size()));
+}
+BENCHMARK(BM_SqrtDiscriminant)
+        ->ArgsProduct({benchmark::CreateRange(10, 10000000, 10),
+                       {IntegerCoefficient, DecimalCoefficient}});
+
+
+// 1万個のdouble (seed固定) を "x\n" の形で書式化する. ostream (std::endl) とOutputBufferを比較
+static void BM_FormatDoubleStream(benchmark::State &state) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::vector<double> values(10000);
+    for (double &value : values) {
+        value = real(engine);
+    }
+    std::ostringstream out;
+
+    for (auto _ : state) {
+        out.str(std::string());
+        for (double value : values) {
+            out << value << std::endl;
+        }
+        benchmark::DoNotOptimize(out.view().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+BENCHMARK(BM_FormatDoubleStream);
+
+static void BM_FormatDoubleBuffer(benchmark::State &state) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::vector<double> values(10000);
+    for (double &value : values) {
+        value = real(engine);
+    }
+    OutputBuffer out;
+
+    for (auto _ : state) {
+        out.clear();
+        for (double value : values) {
+            out.append(value);
+            out.append('\n');
+        }
+        benchmark::DoNotOptimize(out.view().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+BENCHMARK(BM_FormatDoubleBuffer);
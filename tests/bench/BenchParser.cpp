@@ -0,0 +1,61 @@
+#include <string>
+#include "BenchAllocation.hpp"
+#include "BenchEquation.hpp"
+#include "Parser.hpp"
+#include "Tokenizer.hpp"
+#include "benchmark/benchmark.h"
+
+
+// lex -> parse_equation
+static void BM_LexAndParse(benchmark::State &state) {
+    std::string equation = make_equation(static_cast<std::size_t>(state.range(0)));
+    Tokenizer tokenizer;
+
+    for (auto _ : state) {
+        Parser parser;
+        benchmark::DoNotOptimize(tokenizer.lex(equation));
+        benchmark::DoNotOptimize(parser.parse_equation(tokenizer.token_stream()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_LexAndParse)->RangeMultiplier(10)->Range(10, 1000000);
+
+
+// 文字から直接parse (tokenを作らない)
+static void BM_Recognize(benchmark::State &state) {
+    std::string equation = make_equation(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        Parser parser;
+        benchmark::DoNotOptimize(parser.recognize_equation(equation));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_Recognize)->RangeMultiplier(10)->Range(10, 1000000);
+
+
+// lex済みのtoken列をparse_equationする. 係数は整数/小数
+// allocs: 1方程式当たりのheapの確保数
+static void BM_ParseEquation(benchmark::State &state) {
+    std::string equation = make_equation(
+            static_cast<std::size_t>(state.range(0)),
+            static_cast<CoefficientFormat>(state.range(1)));
+    Tokenizer tokenizer;
+    if (tokenizer.lex(equation).is_err()) {
+        state.SkipWithError("lex error");
+        return;
+    }
+    Parser parser;
+    AllocationCounter allocations;
+
+    for (auto _ : state) {
+        parser.reset();
+        benchmark::DoNotOptimize(parser.parse_equation(tokenizer.token_stream()));
+    }
+    set_allocation_counter(state, allocations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_ParseEquation)
+        ->ArgsProduct({benchmark::CreateRange(10, 10000000, 10),
+                       {IntegerCoefficient, DecimalCoefficient}})
+        ->Unit(benchmark::kMicrosecond);
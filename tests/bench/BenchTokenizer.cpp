@@ -0,0 +1,87 @@
+#include <string>
+#include "BenchAllocation.hpp"
+#include "BenchEquation.hpp"
+#include "CharClass.hpp"
+#include "Tokenizer.hpp"
+#include "benchmark/benchmark.h"
+
+
+static void BM_Classify(benchmark::State &state) {
+    CharClass::Kernel kernel = static_cast<CharClass::Kernel>(state.range(0));
+    if (!CharClass::is_supported(kernel)) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+    CharClass::Kernel detected = CharClass::kernel();
+    CharClass::set_kernel(kernel);
+
+    std::string equation = make_equation(1 << 16);
+    CharClass::Masks masks;
+    for (auto _ : state) {
+        for (std::size_t pos = 0; pos < equation.size(); pos += CharClass::kBlockSize) {
+            CharClass::classify(equation.data() + pos, equation.size() - pos, &masks);
+            benchmark::DoNotOptimize(masks);
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+    state.SetLabel(CharClass::kernel_name(kernel));
+    CharClass::set_kernel(detected);
+}
+BENCHMARK(BM_Classify)->DenseRange(CharClass::Scalar, CharClass::AVX2);
+
+
+static void BM_LexByChar(benchmark::State &state) {
+    std::string equation = make_equation(static_cast<std::size_t>(state.range(0)));
+    Tokenizer tokenizer;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer.lex_by_char(equation));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_LexByChar)->RangeMultiplier(10)->Range(10, 1000000);
+
+
+static void BM_Lex(benchmark::State &state) {
+    CharClass::Kernel kernel = static_cast<CharClass::Kernel>(state.range(1));
+    if (!CharClass::is_supported(kernel)) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+    CharClass::Kernel detected = CharClass::kernel();
+    CharClass::set_kernel(kernel);
+
+    std::string equation = make_equation(static_cast<std::size_t>(state.range(0)));
+    Tokenizer tokenizer;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer.lex(equation));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+    state.SetLabel(CharClass::kernel_name(kernel));
+    CharClass::set_kernel(detected);
+}
+BENCHMARK(BM_Lex)->ArgsProduct({
+        benchmark::CreateRange(10, 1000000, 10),
+        benchmark::CreateDenseRange(CharClass::Scalar, CharClass::AVX2, 1)
+});
+
+
+// Tokens (std::deque<s_token>) を作るtokenize(). 係数は整数/小数
+// allocs: 1方程式当たりのheapの確保数
+static void BM_Tokenize(benchmark::State &state) {
+    std::string equation = make_equation(
+            static_cast<std::size_t>(state.range(0)),
+            static_cast<CoefficientFormat>(state.range(1)));
+    Tokenizer tokenizer;
+    AllocationCounter allocations;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer.tokenize(equation));
+    }
+    set_allocation_counter(state, allocations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+}
+BENCHMARK(BM_Tokenize)
+        ->ArgsProduct({benchmark::CreateRange(10, 10000000, 10),
+                       {IntegerCoefficient, DecimalCoefficient}})
+        ->Unit(benchmark::kMicrosecond);
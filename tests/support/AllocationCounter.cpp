@@ -0,0 +1,109 @@
+#include "AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// operator new/deleteから使うため、構築時にheapを確保しないthread_localのみ
+thread_local s_allocation_counts g_counts = {0, 0, 0};
+
+void *allocate(std::size_t size) {
+    ++g_counts.allocations;
+    g_counts.bytes += size;
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *allocate(std::size_t size, std::align_val_t alignment) {
+    ++g_counts.allocations;
+    g_counts.bytes += size;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    void *ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void deallocate(void *ptr) noexcept {
+    if (ptr != nullptr) {
+        ++g_counts.deallocations;
+    }
+    std::free(ptr);
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, alignment);
+}
+// std::stable_sort (get_temporary_buffer) などが使うnothrow版も置き換える
+// (ASanのnothrow版で確保したmemoryを置き換えたdeleteで解放すると、alloc-dealloc-mismatchになる)
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(size, alignment);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+void *operator new[](
+        std::size_t size,
+        std::align_val_t alignment,
+        const std::nothrow_t &tag) noexcept {
+    return operator new(size, alignment, tag);
+}
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+std::ostream &operator<<(std::ostream &os, const s_allocation_counts &counts) {
+    os << "allocations: " << counts.allocations << ", "
+       << "deallocations: " << counts.deallocations << ", "
+       << "bytes: " << counts.bytes;
+    return os;
+}
+
+AllocationCounter::AllocationCounter()
+    : begin_(g_counts) {}
+
+AllocationCounter::~AllocationCounter() {}
+
+s_allocation_counts AllocationCounter::counts() const noexcept(true) {
+    s_allocation_counts counts = {
+            .allocations = g_counts.allocations - this->begin_.allocations,
+            .deallocations = g_counts.deallocations - this->begin_.deallocations,
+            .bytes = g_counts.bytes - this->begin_.bytes
+    };
+    return counts;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+# include <cstdint>
+# include <ostream>
+
+// global operator new/deleteを置き換え、thread毎にheapの確保を数える (AllocationCounter.cpp)
+// utest, benchの両方がlinkする. 別threadでの確保は数えない
+struct s_allocation_counts {
+    std::uint64_t allocations;
+    std::uint64_t deallocations;
+    std::uint64_t bytes;            // 確保したbyte数の合計
+};
+
+std::ostream &operator<<(std::ostream &os, const s_allocation_counts &counts);
+
+// 構築してからのこのthreadのheapの確保を数える
+//   AllocationCounter counter;
+//   pipeline.run(...);
+//   EXPECT_EQ(0u, counter.counts().allocations);
+class AllocationCounter {
+ public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    s_allocation_counts counts() const noexcept(true);
+
+ private:
+    s_allocation_counts begin_;
+
+    // copy invalid
+    AllocationCounter &operator=(const AllocationCounter &rhs);
+    AllocationCounter(const AllocationCounter &other);
+};
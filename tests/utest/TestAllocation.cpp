@@ -0,0 +1,205 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AllocationCounter.hpp"
+#include "computor.hpp"
+#include "OutputBuffer.hpp"
+#include "Pipeline.hpp"
+#include "gtest/gtest.h"
+
+// 置き換えたoperator new/deleteがheapの確保と解放を数えること
+TEST(TestAllocation, TestCounter) {
+    AllocationCounter counter;
+    {
+        std::unique_ptr<int> value = std::make_unique<int>(42);
+        std::vector<double> values;
+        values.reserve(8);
+    }
+    s_allocation_counts counts = counter.counts();
+    EXPECT_EQ(2u, counts.allocations);
+    EXPECT_EQ(2u, counts.deallocations);
+    EXPECT_EQ(sizeof(int) + 8 * sizeof(double), counts.bytes);
+
+    // SSOに収まるstd::stringは確保しない
+    AllocationCounter short_string;
+    std::string text = "X^2";
+    EXPECT_EQ(0u, short_string.counts().allocations);
+}
+
+
+struct AllocationCase {
+    std::string equation;
+    Computor::OutputFormat format;
+    int expected_result;
+    bool is_cached = false;     // SolutionCacheを設定する (2回目以降はcacheにhitする)
+    std::size_t line;
+};
+
+std::ostream &operator<<(std::ostream &os, const AllocationCase &ac) {
+    os << "Equation: " << ac.equation << ", "
+       << "Format: " << ac.format << ", "
+       << "Cached: " << ac.is_cached;
+    return os;
+}
+
+class TestAllocationPipeline : public ::testing::TestWithParam<AllocationCase> {};
+
+// 1度解いて温めたPipelineは、簡約後の方程式をheapを確保せずに
+// tokenize -> parse -> 表示 -> 求解 (cacheの場合は検索) する. 方程式毎の確保数をpropertyとstdoutに書く
+TEST_P(TestAllocationPipeline, TestWarmPipeline) {
+    static constexpr int kRuns = 3;
+    const AllocationCase &param = GetParam();
+    Pipeline pipeline;
+    OutputBuffer out;
+    SolutionCache cache(16);
+    pipeline.set_format(param.format);
+    if (param.is_cached) {
+        pipeline.set_solution_cache(&cache);
+    }
+
+    // 計数中はgtestのassertionを呼ばない (失敗時のmessageがheapを確保する)
+    int results[kRuns + 1];
+    s_allocation_counts warmup;
+    s_allocation_counts steady;
+    {
+        AllocationCounter counter;
+        results[0] = pipeline.run(param.equation, &out, &out);
+        warmup = counter.counts();
+    }
+    out.clear();
+    {
+        AllocationCounter counter;
+        for (int i = 1; i <= kRuns; ++i) {
+            results[i] = pipeline.run(param.equation, &out, &out);
+            out.clear();
+        }
+        steady = counter.counts();
+    }
+    for (int result : results) {
+        EXPECT_EQ(param.expected_result, result) << " at L" << param.line;
+    }
+
+    RecordProperty("warmup_allocations", std::to_string(warmup.allocations));
+    RecordProperty("allocations", std::to_string(steady.allocations / kRuns));
+    std::cout << "[ ALLOCS   ] " << param.equation << " (format " << param.format << ")\n"
+              << "             warm-up: " << warmup << "\n"
+              << "             steady : " << steady << std::endl;
+    EXPECT_EQ(0u, steady.allocations) << steady << " at L" << param.line;
+    EXPECT_EQ(0u, steady.deallocations) << steady << " at L" << param.line;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        ReducedEquation,
+        TestAllocationPipeline,
+        ::testing::Values(
+                AllocationCase{
+                        .equation        = "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "5 * X^0 + 4 * X^1 = 4 * X^0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "42 * X^0 = 42 * X^0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_FAILURE,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "x^2 + 1 = 0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "x^2 = 2x - 1",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^100 - X^100 + X^2 = 1",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "8 - 6X - 5.6X^3 = 3",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^4 - 5 * X^2 + 4 = 0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^6 - 2 * X^3 + 1 = 0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^8 - 2 * X + 1 = 0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+                        .format          = Computor::JSON,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^4 - 5 * X^2 + 4 = 0",
+                        .format          = Computor::JSON,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "x^2 + 1 = 0",
+                        .format          = Computor::BINARY,
+                        .expected_result = EXIT_SUCCESS,
+                        .line            = __LINE__
+                }
+        )
+);
+
+
+INSTANTIATE_TEST_SUITE_P(
+        CachedEquation,
+        TestAllocationPipeline,
+        ::testing::Values(
+                AllocationCase{
+                        .equation        = "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .is_cached       = true,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^8 - 2 * X + 1 = 0",
+                        .format          = Computor::TEXT,
+                        .expected_result = EXIT_SUCCESS,
+                        .is_cached       = true,
+                        .line            = __LINE__
+                },
+                AllocationCase{
+                        .equation        = "X^4 - 5 * X^2 + 4 = 0",
+                        .format          = Computor::JSON,
+                        .expected_result = EXIT_SUCCESS,
+                        .is_cached       = true,
+                        .line            = __LINE__
+                }
+        )
+);
@@ -0,0 +1,93 @@
+#include <memory_resource>
+#include <sstream>
+#include <vector>
+#include "Arena.hpp"
+#include "Calculator.hpp"
+#include "Pipeline.hpp"
+#include "Polynomial.hpp"
+#include "gtest/gtest.h"
+
+TEST(TestArena, TestRelease) {
+    Arena arena;
+
+    // bufferに収まる確保はheapを使わない
+    {
+        std::pmr::vector<int> values(&arena);
+        values.reserve(16);
+        EXPECT_EQ(1u, arena.counts().allocations);
+        EXPECT_EQ(16 * sizeof(int), arena.counts().bytes);
+        EXPECT_EQ(0u, arena.counts().upstream_allocations);
+    }
+    arena.release();
+    EXPECT_EQ(1u, arena.counts().releases);
+
+    // bufferを超えた分はheapから確保し、release()で解放する
+    {
+        std::pmr::vector<char> large(Arena::kBufferBytes * 2, 'a', &arena);
+        EXPECT_EQ(1u, arena.counts().upstream_allocations);
+    }
+    arena.release();
+
+    // release()後は再びbufferの先頭から確保する
+    void *first = arena.allocate(8);
+    arena.release();
+    EXPECT_EQ(first, arena.allocate(8));
+    EXPECT_EQ(4u, arena.counts().allocations);
+    EXPECT_EQ(1u, arena.counts().upstream_allocations);
+}
+
+// arenaの多項式のコピー, moveは既定のresourceを使い、arenaのrelease()後も有効
+TEST(TestArena, TestPolynomial) {
+    Arena arena;
+    Polynomials copied;
+    Polynomials moved;
+    {
+        Polynomials polynomial(&arena);
+        polynomial[-1] = 1.0;
+        polynomial[2] = 3.0;
+        polynomial[100] = 2.0;
+        EXPECT_EQ(2u, arena.counts().allocations);
+
+        copied = polynomial;
+        moved = Polynomials(std::move(polynomial));
+    }
+    arena.release();
+
+    Polynomials expected = {{-1, 1.0}, {2, 3.0}, {100, 2.0}};
+    EXPECT_EQ(expected, copied);
+    EXPECT_EQ(expected, moved);
+}
+
+// 3, 4次方程式の途中の根はarenaから確保し、heapを使わない
+TEST(TestArena, TestCalculator) {
+    Arena arena;
+    Calculator calculator(&arena);
+
+    // X^3 - X = 0
+    EXPECT_EQ(QuadraticSolver::ThreeRealSolutionsCubic,
+              calculator.solve_equation({{1, -1.0}, {3, 1.0}}));
+    EXPECT_EQ(3u, calculator.solutions().size());
+    arena.release();
+
+    // X^4 - 5X^2 + 4 = 0
+    EXPECT_EQ(QuadraticSolver::FourRealSolutionsQuartic,
+              calculator.solve_equation({{0, 4.0}, {2, -5.0}, {4, 1.0}}));
+    EXPECT_EQ(4u, calculator.solutions().size());
+    arena.release();
+
+    EXPECT_LT(0u, arena.counts().allocations);
+    EXPECT_EQ(0u, arena.counts().upstream_allocations);
+}
+
+// Pipelineは方程式毎にarenaをrelease()する
+TEST(TestArena, TestPipeline) {
+    Pipeline pipeline;
+    std::ostringstream out, err;
+
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("X^3 = X", out, err));
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("X^2 = 1", out, err));
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("X^20 = 1", out, err));
+    EXPECT_EQ(3u, pipeline.arena_counts().releases);
+    EXPECT_LT(0u, pipeline.arena_counts().allocations);
+    EXPECT_EQ("", err.str());
+}
@@ -1,4 +1,5 @@
 #include "TestCalcEquation.h"
+#include "Pipeline.hpp"
 
 
 std::ostream &operator<<(std::ostream &os, const TestCase& tc) {
@@ -44,6 +45,38 @@ TEST_P(TestComputor, TestComputorOutput) {
     EXPECT_EQ(expected_stderr, captured_cerr.str()) << " at L" << param.line;
 }
 
+// 項の境界ごとに区切ってparseしても、calc_equation()と同じ出力になること
+TEST_P(TestComputor, TestComputorStreamOutput) {
+    TestCase param = GetParam();
+
+    for (std::size_t chunk_size : {1, 7, 64}) {
+        captured_cout.str("");
+        captured_cerr.str("");
+        std::istringstream in(param.equation);
+
+        int actual_result = Computor::calc_equation_stream(in, chunk_size);
+
+        EXPECT_EQ(param.expected_result, actual_result)
+            << " at L" << param.line << ", chunk_size: " << chunk_size;
+        EXPECT_EQ(param.expected_stdout, captured_cout.str())
+            << " at L" << param.line << ", chunk_size: " << chunk_size;
+        EXPECT_EQ(param.expected_stderr, captured_cerr.str())
+            << " at L" << param.line << ", chunk_size: " << chunk_size;
+    }
+}
+
+// 全caseで同じPipelineを再利用しても、calc_equation()と同じ出力になること
+TEST_P(TestComputor, TestComputorPipelineOutput) {
+    static Pipeline pipeline;
+    TestCase param = GetParam();
+
+    int actual_result = pipeline.run(param.equation, std::cout, std::cerr);
+
+    EXPECT_EQ(param.expected_result, actual_result) << " at L" << param.line;
+    EXPECT_EQ(param.expected_stdout, captured_cout.str()) << " at L" << param.line;
+    EXPECT_EQ(param.expected_stderr, captured_cerr.str()) << " at L" << param.line;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 INSTANTIATE_TEST_SUITE_P(
@@ -73,10 +106,13 @@ INSTANTIATE_TEST_SUITE_P(
                 },
                 TestCase{
                         .equation        = "8 * X^0 - 6 * X^1 + 0 * X^2 - 5.6 * X^3 = 3 * X^0",
-                        .expected_result = EXIT_FAILURE,
+                        .expected_result = EXIT_SUCCESS,
                         .expected_stdout = "Reduced form     : 5.6 * X^3 + 6 * X - 5 = 0\n"
                                            "Polynomial degree: 3\n"
-                                           "The polynomial degree is strictly greater than 2, I can't solve.\n",
+                                           "Discriminant is negative, the three solutions are:\n"
+                                           " 0.615598\n"
+                                           "-0.307799+1.16432i\n"
+                                           "-0.307799-1.16432i\n",
                         .expected_stderr = "",
                         .line = __LINE__
                 }
@@ -552,42 +588,369 @@ INSTANTIATE_TEST_SUITE_P(
 ////////////////////////////////////////////////////////////////////////////////
 
 INSTANTIATE_TEST_SUITE_P(
-        ErrorCasesDegreeTooLarge,
+        CubicEquation,
         TestComputor,
         ::testing::Values(
                 TestCase{
                         .equation        = "X^3 = 0",
-                        .expected_result = EXIT_FAILURE,
+                        .expected_result = EXIT_SUCCESS,
                         .expected_stdout = "Reduced form     : 1 * X^3 = 0\n"
                                            "Polynomial degree: 3\n"
-                                           "The polynomial degree is strictly greater than 2, I can't solve.\n",
+                                           "Discriminant is zero, the solutions are:\n"
+                                           "0\n",
                         .expected_stderr = "",
                         .line = __LINE__
                 },
                 TestCase{
                         .equation        = "x^3 - 2x + 1 = 0",
-                        .expected_result = EXIT_FAILURE,
+                        .expected_result = EXIT_SUCCESS,
                         .expected_stdout = "Reduced form     : 1 * x^3 - 2 * x + 1 = 0\n"
                                            "Polynomial degree: 3\n"
-                                           "The polynomial degree is strictly greater than 2, I can't solve.\n",
+                                           "Discriminant is positive, the three solutions are:\n"
+                                           " 1\n"
+                                           " 0.618034\n"
+                                           "-1.61803\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "0 * X^2147483647 + 1 * X^3 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^3 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is zero, the solutions are:\n"
+                                           "0\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^3 + x = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^3 + 1 * x = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is negative, the three solutions are:\n"
+                                           "0+1i\n"
+                                           "0\n"
+                                           "0-1i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^3 - 3x + 2 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^3 - 3 * x + 2 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is zero, the solutions are:\n"
+                                           " 1\n"
+                                           "-2\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^3 - 3x^2 + 3x - 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^3 - 3 * x^2 + 3 * x - 1 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is zero, the solutions are:\n"
+                                           " 1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^3 - 0.000000001 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^3 - 1e-09 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is negative, the three solutions are:\n"
+                                           " 0.001\n"
+                                           "-0.0005+0.000866025i\n"
+                                           "-0.0005-0.000866025i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "0.00000001x^3 + x^2 + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1e-08 * x^3 + 1 * x^2 + 1 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 5e-09+1i\n"
+                                           " 5e-09-1i\n"
+                                           "-1e+08\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "X^3 - 2 * X^2 + X - 2 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^3 - 2 * X^2 + 1 * X - 2 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is negative, the three solutions are:\n"
+                                           " 2\n"
+                                           "0+1i\n"
+                                           "0-1i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "X^3 + X^2 + X + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^3 + 1 * X^2 + 1 * X + 1 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "Discriminant is negative, the three solutions are:\n"
+                                           "0+1i\n"
+                                           "0-1i\n"
+                                           "-1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "0." + std::string(199, '0') + "1 * X^3 - 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1e-200 * X^3 - 1 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 4.64159e+66\n"
+                                           "-2.32079e+66+4.01973e+66i\n"
+                                           "-2.32079e+66-4.01973e+66i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "1" + std::string(307, '0') + " * X^3 + 0."
+                                           + std::string(300, '0') + "1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1e+307 * X^3 + 1e-301 = 0\n"
+                                           "Polynomial degree: 3\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 1.07722e-203+1.8658e-203i\n"
+                                           " 1.07722e-203-1.8658e-203i\n"
+                                           "-2.15443e-203\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                }
+        )
+);
+
+
+INSTANTIATE_TEST_SUITE_P(
+        QuarticEquation,
+        TestComputor,
+        ::testing::Values(
+                TestCase{
+                        .equation        = "X^4 + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^4 + 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are complex, the solutions are:\n"
+                                           " 0.707107+0.707107i\n"
+                                           " 0.707107-0.707107i\n"
+                                           "-0.707107+0.707107i\n"
+                                           "-0.707107-0.707107i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 - 10x^3 + 35x^2 - 50x + 24 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 - 10 * x^3 + 35 * x^2 - 50 * x + 24 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are real, the solutions are:\n"
+                                           " 4\n"
+                                           " 3\n"
+                                           " 2\n"
+                                           " 1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 - 5x^2 + 4 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 - 5 * x^2 + 4 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are real, the solutions are:\n"
+                                           " 2\n"
+                                           " 1\n"
+                                           "-1\n"
+                                           "-2\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 - 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 - 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "The solutions are real and complex:\n"
+                                           " 1\n"
+                                           "0+1i\n"
+                                           "0-1i\n"
+                                           "-1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 + x + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 + 1 * x + 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are complex, the solutions are:\n"
+                                           " 0.727136+0.934099i\n"
+                                           " 0.727136-0.934099i\n"
+                                           "-0.727136+0.430014i\n"
+                                           "-0.727136-0.430014i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 - 4x^3 + 6x^2 - 4x + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 - 4 * x^3 + 6 * x^2 - 4 * x + 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are real, the solutions are:\n"
+                                           " 1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 + 2x^2 + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 + 2 * x^2 + 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are complex, the solutions are:\n"
+                                           "0+1i\n"
+                                           "0-1i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "x^4 + x^3 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * x^4 + 1 * x^3 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "All solutions are real, the solutions are:\n"
+                                           "0\n"
+                                           "-1\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "0.00000001x^4 + x^3 + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1e-08 * x^4 + 1 * x^3 + 1 = 0\n"
+                                           "Polynomial degree: 4\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 0.5+0.866025i\n"
+                                           " 0.5-0.866025i\n"
+                                           "-1\n"
+                                           "-1e+08\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                }
+        )
+);
+
+
+INSTANTIATE_TEST_SUITE_P(
+        PolynomialEquation,
+        TestComputor,
+        ::testing::Values(
+                TestCase{
+                        .equation        = "X^5 - 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^5 - 1 = 0\n"
+                                           "Polynomial degree: 5\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 1\n"
+                                           " 0.309017+0.951057i\n"
+                                           " 0.309017-0.951057i\n"
+                                           "-0.809017+0.587785i\n"
+                                           "-0.809017-0.587785i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "X^6 - 2X^3 + 1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^6 - 2 * X^3 + 1 = 0\n"
+                                           "Polynomial degree: 6\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 1\n"
+                                           "-0.5+0.866025i\n"
+                                           "-0.5-0.866025i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "X^5 + X^3 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^5 + 1 * X^3 = 0\n"
+                                           "Polynomial degree: 5\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           "0+1i\n"
+                                           "0\n"
+                                           "0-1i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "X^5 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^5 = 0\n"
+                                           "Polynomial degree: 5\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           "0\n",
                         .expected_stderr = "",
                         .line = __LINE__
                 },
+                TestCase{
+                        .equation        = "X^4097 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1 * X^4097 = 0\n"
+                                           "Polynomial degree: 4097\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           "0\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                },
+                TestCase{
+                        .equation        = "1" + std::string(200, '0') + " * X^5 - 0."
+                                           + std::string(199, '0') + "1 = 0",
+                        .expected_result = EXIT_SUCCESS,
+                        .expected_stdout = "Reduced form     : 1e+200 * X^5 - 1e-200 = 0\n"
+                                           "Polynomial degree: 5\n"
+                                           "The polynomial degree is strictly greater than 2, the solutions are:\n"
+                                           " 1e-80\n"
+                                           " 3.09017e-81+9.51057e-81i\n"
+                                           " 3.09017e-81-9.51057e-81i\n"
+                                           "-8.09017e-81+5.87785e-81i\n"
+                                           "-8.09017e-81-5.87785e-81i\n",
+                        .expected_stderr = "",
+                        .line = __LINE__
+                }
+        )
+);
+
+
+INSTANTIATE_TEST_SUITE_P(
+        ErrorCasesDegreeTooLarge,
+        TestComputor,
+        ::testing::Values(
                 TestCase{
                         .equation        = "X^2147483647 = 0",
                         .expected_result = EXIT_FAILURE,
                         .expected_stdout = "Reduced form     : 1 * X^2147483647 = 0\n"
                                            "Polynomial degree: 2147483647\n"
-                                           "The polynomial degree is strictly greater than 2, I can't solve.\n",
+                                           "The polynomial degree is strictly greater than 16384, I can't solve.\n",
                         .expected_stderr = "",
                         .line = __LINE__
                 },
                 TestCase{
-                        .equation        = "0 * X^2147483647 + 1 * X^3 = 0",
+                        .equation        = "X^16385 = 0",
                         .expected_result = EXIT_FAILURE,
-                        .expected_stdout = "Reduced form     : 1 * X^3 = 0\n"
-                                           "Polynomial degree: 3\n"
-                                           "The polynomial degree is strictly greater than 2, I can't solve.\n",
+                        .expected_stdout = "Reduced form     : 1 * X^16385 = 0\n"
+                                           "Polynomial degree: 16385\n"
+                                           "The polynomial degree is strictly greater than 16384, I can't solve.\n",
                         .expected_stderr = "",
                         .line = __LINE__
                 }
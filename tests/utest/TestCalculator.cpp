@@ -0,0 +1,103 @@
+#include <random>
+#include <vector>
+#include "Calculator.hpp"
+#include "OutputBuffer.hpp"
+#include "Polynomial.hpp"
+#include "gtest/gtest.h"
+
+// 1つのCalculatorで次数の異なる方程式を順に解き、前の解を引き継がないこと
+TEST(TestCalculator, TestReuse) {
+    Calculator calculator;
+    OutputBuffer out;
+
+    // X^2 - 1 = 0
+    EXPECT_EQ(EXIT_SUCCESS, calculator.solve_quadratic_equation({{0, -1.0}, {2, 1.0}}, &out));
+    EXPECT_EQ("Discriminant is positive, the two solutions are:\n"
+              " 1\n"
+              "-1\n", out.view());
+
+    // 1 = 0
+    out.clear();
+    EXPECT_EQ(EXIT_FAILURE, calculator.solve_quadratic_equation({{0, 1.0}}, &out));
+    EXPECT_EQ("I can't solve.\n", out.view());
+    EXPECT_EQ(QuadraticSolver::NoSolution, calculator.solution_type());
+    EXPECT_TRUE(calculator.solutions().empty());
+
+    // 2X + 1 = 0
+    out.clear();
+    EXPECT_EQ(EXIT_SUCCESS, calculator.solve_quadratic_equation({{0, 1.0}, {1, 2.0}}, &out));
+    EXPECT_EQ("The solution is:\n"
+              "-0.5\n", out.view());
+
+    // X^3 - X = 0
+    EXPECT_EQ(QuadraticSolver::ThreeRealSolutionsCubic,
+              calculator.solve_equation({{1, -1.0}, {3, 1.0}}));
+    EXPECT_EQ(3u, calculator.solutions().size());
+
+    calculator.reset();
+    EXPECT_EQ(QuadraticSolver::NoSolutionCalculationError, calculator.solution_type());
+    EXPECT_TRUE(calculator.solutions().empty());
+}
+
+// 2次以下の方程式では、解のvectorのcapacityを再利用する
+TEST(TestCalculator, TestRetainCapacity) {
+    Calculator calculator;
+    Polynomials two_real = {{0, -1.0}, {2, 1.0}};
+    Polynomials two_complex = {{0, 1.0}, {2, 1.0}};
+    Polynomials linear = {{0, 1.0}, {1, 2.0}};
+
+    calculator.solve_equation(two_real);
+    const QuadraticSolver::Solution *data = calculator.solutions().data();
+    std::size_t capacity = calculator.solutions().capacity();
+
+    for (const Polynomials &polynomial : {two_complex, linear, two_real}) {
+        calculator.solve_equation(polynomial);
+        EXPECT_EQ(data, calculator.solutions().data());
+        EXPECT_EQ(capacity, calculator.solutions().capacity());
+    }
+}
+
+// RootFinderは方程式間で再利用し、並列の設定でも同じ方程式は同じ解になる (seed固定)
+TEST(TestCalculator, TestRootFinderReuse) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    Polynomials polynomial;
+    for (std::int32_t degree = 0; degree <= 600; ++degree) {
+        polynomial[degree] = real(engine);
+    }
+    s_root_finder_config config;
+    config.threads = 2;
+    Calculator calculator;
+    calculator.set_root_finder_config(config);
+
+    EXPECT_EQ(QuadraticSolver::SolutionsPolynomial, calculator.solve_equation(polynomial));
+    std::vector<QuadraticSolver::Solution> first = calculator.solutions();
+    EXPECT_EQ(QuadraticSolver::SolutionsPolynomial, calculator.solve_equation(polynomial));
+    ASSERT_EQ(first.size(), calculator.solutions().size());
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i].re, calculator.solutions()[i].re);
+        EXPECT_EQ(first[i].im, calculator.solutions()[i].im);
+    }
+
+    // 5次以上の方程式も、2回目以降は解の配列を再利用する
+    Polynomials quintic = {{0, -1.0}, {5, 1.0}};
+    calculator.solve_equation(quintic);
+    const QuadraticSolver::Solution *data = calculator.solutions().data();
+    calculator.solve_equation(quintic);
+    EXPECT_EQ(data, calculator.solutions().data());
+}
+
+// RootFinderが収束しない場合、前の方程式の解を残さない
+TEST(TestCalculator, TestNoStaleSolutions) {
+    Calculator calculator;
+    Polynomials quintic = {{0, -1.0}, {5, 1.0}};
+    ASSERT_EQ(QuadraticSolver::SolutionsPolynomial, calculator.solve_equation(quintic));
+    ASSERT_FALSE(calculator.solutions().empty());
+
+    s_root_finder_config config;
+    config.max_iterations = 1;
+    calculator.set_root_finder_config(config);
+    Polynomials sextic = {{0, -2.0}, {1, 3.0}, {6, 1.0}};
+    EXPECT_EQ(QuadraticSolver::NoSolutionCalculationError, calculator.solve_equation(sextic));
+    EXPECT_TRUE(calculator.solutions().empty());
+}
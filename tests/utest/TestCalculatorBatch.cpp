@@ -0,0 +1,147 @@
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include "Calculator.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct s_batch {
+    std::vector<double> a, b, c;
+    std::vector<QuadraticSolver::SolutionType> types;
+    std::vector<double> re1, im1, re2, im2;
+
+    void push(double a_, double b_, double c_) {
+        this->a.push_back(a_);
+        this->b.push_back(b_);
+        this->c.push_back(c_);
+    }
+
+    void solve(QuadraticSolver::BatchIsa isa) {
+        std::size_t size = this->a.size();
+        this->types.assign(size, QuadraticSolver::NoSolution);
+        this->re1.assign(size, -1.0);
+        this->im1.assign(size, -1.0);
+        this->re2.assign(size, -1.0);
+        this->im2.assign(size, -1.0);
+        Calculator::solve_quadratic_batch(
+                {this->a.data(), this->b.data(), this->c.data()},
+                {this->types.data(), this->re1.data(), this->im1.data(),
+                 this->re2.data(), this->im2.data()},
+                size,
+                isa);
+    }
+};
+
+std::vector<QuadraticSolver::BatchIsa> available_isa() {
+    std::vector<QuadraticSolver::BatchIsa> isa = {QuadraticSolver::Scalar};
+    QuadraticSolver::BatchIsa detected = Calculator::detect_batch_isa();
+    if (detected == QuadraticSolver::Avx2 || detected == QuadraticSolver::Avx512) {
+        isa.push_back(QuadraticSolver::Avx2);
+    }
+    if (detected == QuadraticSolver::Avx512) {
+        isa.push_back(QuadraticSolver::Avx512);
+    }
+    return isa;
+}
+
+bool is_same_bits(const std::vector<double> &lhs, const std::vector<double> &rhs) {
+    if (lhs.size() != rhs.size()) { return false; }
+    return lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(double)) == 0;
+}
+
+}  // namespace
+
+TEST(TestCalculatorBatch, TestSolutionType) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    s_batch batch;
+
+    batch.push(1, 0, -1);       // x^2 - 1
+    batch.push(1, 2, 5);        // x^2 + 2x + 5
+    batch.push(1, 2, 1);        // x^2 + 2x + 1
+    batch.push(0, 4, 1);        // 4x + 1
+    batch.push(0, 0, 0);        // 0 = 0
+    batch.push(0, 0, 3);        // 3 = 0
+    batch.push(1e200, 1e200, 1e200);    // D = inf - inf
+    batch.push(nan, 1, 1);
+    batch.push(1, inf, 0);
+    batch.push(-0.0, -0.0, 0);  // 0 = 0
+    batch.push(0, nan, 1);      // Linear (nan != 0)
+    batch.push(0, 0, nan);      // nan != 0 -> NoSolution
+
+    for (QuadraticSolver::BatchIsa isa : available_isa()) {
+        batch.solve(isa);
+        std::vector<QuadraticSolver::SolutionType> expected = {
+                QuadraticSolver::TwoRealSolutionsQuadratic,
+                QuadraticSolver::TwoComplexSolutionsQuadratic,
+                QuadraticSolver::OneRealSolutionQuadratic,
+                QuadraticSolver::OneRealSolutionLinear,
+                QuadraticSolver::Indeterminate,
+                QuadraticSolver::NoSolution,
+                QuadraticSolver::NoSolutionCalculationError,
+                QuadraticSolver::NoSolutionCalculationError,
+                QuadraticSolver::NoSolutionCalculationError,
+                QuadraticSolver::Indeterminate,
+                QuadraticSolver::OneRealSolutionLinear,
+                QuadraticSolver::NoSolution,
+        };
+        EXPECT_EQ(expected, batch.types) << "isa: " << isa;
+
+        EXPECT_EQ(1.0, batch.re1[0]);
+        EXPECT_EQ(-1.0, batch.re2[0]);
+        EXPECT_EQ(0.0, batch.im1[0]);
+        EXPECT_EQ(-1.0, batch.re1[1]);
+        EXPECT_EQ(2.0, batch.im1[1]);
+        EXPECT_EQ(-1.0, batch.re2[1]);
+        EXPECT_EQ(-2.0, batch.im2[1]);
+        EXPECT_EQ(-1.0, batch.re1[2]);
+        EXPECT_EQ(0.0, batch.re2[2]);
+        EXPECT_EQ(-0.25, batch.re1[3]);
+        for (std::size_t i = 4; i < 10; ++i) {
+            EXPECT_EQ(0.0, batch.re1[i]) << "i: " << i;
+            EXPECT_EQ(0.0, batch.im1[i]) << "i: " << i;
+            EXPECT_EQ(0.0, batch.re2[i]) << "i: " << i;
+            EXPECT_EQ(0.0, batch.im2[i]) << "i: " << i;
+        }
+    }
+}
+
+// 全ての命令セットの結果がscalarとbit単位で一致する (端数の要素数も含む)
+TEST(TestCalculatorBatch, TestSameAsScalar) {
+    const double special[] = {
+            0.0, -0.0, 1.0, -1.0, 0.5, 4.0, 1e-300, 1e300,
+            std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::quiet_NaN(),
+    };
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-100.0, 100.0);
+    std::uniform_int_distribution<int> integer(-5, 5);
+
+    for (std::size_t size : {0, 1, 3, 4, 7, 8, 9, 15, 1001}) {
+        s_batch batch;
+        for (std::size_t i = 0; i < size; ++i) {
+            double coefficient[3];
+            for (double &value : coefficient) {
+                switch (engine() % 3) {
+                    case 0: value = special[engine() % 10]; break;
+                    case 1: value = integer(engine); break;
+                    default: value = real(engine); break;
+                }
+            }
+            batch.push(coefficient[0], coefficient[1], coefficient[2]);
+        }
+
+        batch.solve(QuadraticSolver::Scalar);
+        s_batch expected = batch;
+        for (QuadraticSolver::BatchIsa isa : available_isa()) {
+            batch.solve(isa);
+            EXPECT_EQ(expected.types, batch.types) << "isa: " << isa << " size: " << size;
+            EXPECT_TRUE(is_same_bits(expected.re1, batch.re1)) << "isa: " << isa;
+            EXPECT_TRUE(is_same_bits(expected.im1, batch.im1)) << "isa: " << isa;
+            EXPECT_TRUE(is_same_bits(expected.re2, batch.re2)) << "isa: " << isa;
+            EXPECT_TRUE(is_same_bits(expected.im2, batch.im2)) << "isa: " << isa;
+        }
+    }
+}
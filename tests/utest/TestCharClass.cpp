@@ -0,0 +1,109 @@
+#include <random>
+#include <string>
+#include "CharClass.hpp"
+#include "gtest/gtest.h"
+
+void expect_eq_masks(
+        const CharClass::Masks &expected,
+        const CharClass::Masks &actual,
+        const std::string &kernel,
+        std::size_t line) {
+    EXPECT_EQ(expected.digit, actual.digit) << " kernel: " << kernel << " at L:" << line;
+    EXPECT_EQ(expected.alpha, actual.alpha) << " kernel: " << kernel << " at L:" << line;
+    EXPECT_EQ(expected.space, actual.space) << " kernel: " << kernel << " at L:" << line;
+    EXPECT_EQ(expected.dot, actual.dot) << " kernel: " << kernel << " at L:" << line;
+    EXPECT_EQ(expected.op, actual.op) << " kernel: " << kernel << " at L:" << line;
+}
+
+void classify_by_kernel(
+        CharClass::Kernel kernel,
+        const char *block,
+        std::size_t len,
+        CharClass::Masks *masks) {
+    switch (kernel) {
+#if defined(__x86_64__) || defined(__i386__)
+        case CharClass::SSE2:
+            CharClass::classify_sse2(block, len, masks);
+            break;
+        case CharClass::AVX2:
+            CharClass::classify_avx2(block, len, masks);
+            break;
+#endif
+        default:
+            CharClass::classify_scalar(block, len, masks);
+            break;
+    }
+}
+
+TEST(TestCharClass, TestScalar) {
+    CharClass::Masks masks;
+    std::string block;
+
+    block = "";
+    CharClass::classify_scalar(block.data(), block.size(), &masks);
+    expect_eq_masks({0, 0, 0, 0, 0}, masks, "scalar", __LINE__);
+
+    block = "1.5x^2 + X = 0";
+    //       01234567890123
+    CharClass::classify_scalar(block.data(), block.size(), &masks);
+    expect_eq_masks({
+            .digit = 0b10000000100101,
+            .alpha = 0b00001000001000,
+            .space = 0b01010101000000,
+            .dot   = 0b00000000000010,
+            .op    = 0b00100010010000,
+    }, masks, "scalar", __LINE__);
+
+    // 64byteを超える分は無視
+    block = std::string(100, '1');
+    CharClass::classify_scalar(block.data(), block.size(), &masks);
+    expect_eq_masks({~std::uint64_t(0), 0, 0, 0, 0}, masks, "scalar", __LINE__);
+}
+
+TEST(TestCharClass, TestAllKernelsSameAsScalar) {
+    CharClass::Kernel kernels[] = {CharClass::Scalar, CharClass::SSE2, CharClass::AVX2};
+    CharClass::Masks expected, actual;
+    char block[CharClass::kBlockSize];
+
+    // 全byte値
+    for (int c = 0; c < 256; ++c) {
+        for (std::size_t i = 0; i < CharClass::kBlockSize; ++i) {
+            block[i] = static_cast<char>((c + i) % 256);
+        }
+        CharClass::classify_scalar(block, CharClass::kBlockSize, &expected);
+        for (auto kernel : kernels) {
+            if (!CharClass::is_supported(kernel)) { continue; }
+            classify_by_kernel(kernel, block, CharClass::kBlockSize, &actual);
+            expect_eq_masks(expected, actual, CharClass::kernel_name(kernel), __LINE__);
+        }
+    }
+
+    // 64byte未満のblock
+    std::mt19937 engine(42);
+    std::string charset = "0123456789.+-*=^ xX#\t";
+    for (std::size_t len = 0; len <= CharClass::kBlockSize; ++len) {
+        for (std::size_t i = 0; i < CharClass::kBlockSize; ++i) {
+            block[i] = charset[engine() % charset.size()];
+        }
+        CharClass::classify_scalar(block, len, &expected);
+        for (auto kernel : kernels) {
+            if (!CharClass::is_supported(kernel)) { continue; }
+            classify_by_kernel(kernel, block, len, &actual);
+            expect_eq_masks(expected, actual, CharClass::kernel_name(kernel), __LINE__);
+        }
+    }
+}
+
+TEST(TestCharClass, TestDispatch) {
+    CharClass::Kernel detected = CharClass::detect_kernel();
+
+    EXPECT_TRUE(CharClass::is_supported(detected));
+    EXPECT_TRUE(CharClass::is_supported(CharClass::Scalar));
+    EXPECT_EQ(detected, CharClass::kernel());
+
+    EXPECT_TRUE(CharClass::set_kernel(CharClass::Scalar));
+    EXPECT_EQ(CharClass::Scalar, CharClass::kernel());
+
+    EXPECT_TRUE(CharClass::set_kernel(detected));
+    EXPECT_EQ(detected, CharClass::kernel());
+}
@@ -0,0 +1,144 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EquationStream.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// lex() -> parse_equation()の結果. tokenizerのerrorを優先する
+Result<Polynomials, ErrMsg> parse_at_once(const std::string &equation) {
+    Tokenizer tokenizer;
+    Parser parser;
+
+    Result<Computor::Status, ErrMsg> lex_result = tokenizer.lex(equation);
+    if (lex_result.is_err()) {
+        return Result<Polynomials, ErrMsg>::err(lex_result.err_value());
+    }
+    return parser.parse_equation(tokenizer.token_stream());
+}
+
+void expect_same_result(
+        const Result<Polynomials, ErrMsg> &expected,
+        const Result<Polynomials, ErrMsg> &actual,
+        const std::string &equation,
+        std::size_t chunk_size) {
+    ASSERT_EQ(expected.is_ok(), actual.is_ok())
+        << equation << ", chunk_size: " << chunk_size;
+    if (expected.is_ok()) {
+        EXPECT_EQ(expected.ok_value(), actual.ok_value())
+            << equation << ", chunk_size: " << chunk_size;
+    } else {
+        EXPECT_EQ(expected.err_value(), actual.err_value())
+            << equation << ", chunk_size: " << chunk_size;
+    }
+}
+
+std::string make_term(std::mt19937 *engine, bool is_first) {
+    const char *operators[] = {" + ", " - ", "+", "-"};
+    const char *coefs[] = {"", "1", "2.5", "10", "0", "123.456", "7"};
+    const char *bases[] = {"", "X", "X^0", "X^1", "X^2", "X^3", "X^12"};
+    std::string term;
+
+    if (!is_first || (*engine)() % 3 == 0) {
+        term += operators[(*engine)() % 4];
+    }
+    std::string coef = coefs[(*engine)() % 7];
+    std::string base = bases[(*engine)() % 7];
+    if (coef.empty() && base.empty()) {
+        coef = "1";
+    }
+    term += coef;
+    if (!coef.empty() && !base.empty()) {
+        term += (*engine)() % 2 ? " * " : "";
+    }
+    term += base;
+    return term;
+}
+
+}  // namespace
+
+
+TEST(TestEquationStream, SameAsParseEquation) {
+    std::mt19937 engine(42);
+    std::vector<std::string> equations = {
+            "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+            "",
+            "   ",
+            "=",
+            "X",
+            "X =",
+            "= X",
+            "X = = 1",
+            "X = 1 = 1",
+            "X + = 1",
+            "X = 1 +",
+            "2 * = X",
+            "2 * - X = 0",
+            "X^ + 1 = 0",
+            "X^-2 = 0",
+            "X = 1 2",
+            "X = 1 + Y",       // tokenizer error (base)
+            "X + * = 1 + Y",   // tokenizer errorを優先
+            "X + * = 1 + #",
+            "X^99999999999 = 0",
+            "X = " + std::string(400, '9'),
+            std::string(100, ' ') + "X^2 " + std::string(100, ' ') + "= 0",
+            "X = 1\n",
+    };
+    for (int i = 0; i < 300; ++i) {
+        std::string equation;
+        std::size_t lhs_terms = 1 + engine() % 6;
+        std::size_t rhs_terms = 1 + engine() % 3;
+        for (std::size_t j = 0; j < lhs_terms; ++j) {
+            equation += make_term(&engine, j == 0);
+        }
+        equation += " = ";
+        for (std::size_t j = 0; j < rhs_terms; ++j) {
+            equation += make_term(&engine, j == 0);
+        }
+        // 1文字を壊したerror caseも混ぜる
+        if (i % 4 == 0) {
+            std::string charset = "+-*=^. xX#";
+            equation[engine() % equation.size()] = charset[engine() % charset.size()];
+        }
+        equations.push_back(equation);
+    }
+
+    for (const auto &equation : equations) {
+        Result<Polynomials, ErrMsg> expected = parse_at_once(
+                std::string(Computor::trim_newline(equation)));
+
+        for (std::size_t chunk_size : {1, 2, 5, 16, 4096}) {
+            EquationStream stream(chunk_size);
+            Parser stream_parser, view_parser;
+            std::istringstream in(equation);
+
+            Result<Polynomials, ErrMsg> actual = stream.parse(in, &stream_parser);
+            expect_same_result(expected, actual, equation, chunk_size);
+
+            actual = stream.parse(std::string_view(equation), &view_parser);
+            expect_same_result(expected, actual, equation, chunk_size);
+        }
+    }
+}
+
+TEST(TestEquationStream, ReduceLongEquation) {
+    EquationStream stream(64);
+    Parser parser;
+    std::stringstream in;
+
+    // 1 + 1 + ... + 1 = 100000 * X^2
+    in << "1";
+    for (int i = 1; i < 100000; ++i) {
+        in << " + 1";
+    }
+    in << " = 100000 * X^2\n";
+
+    Result<Polynomials, ErrMsg> result = stream.parse(in, &parser);
+    ASSERT_TRUE(result.is_ok());
+    Polynomials expected = {{0, -100000}, {2, 100000}};
+    EXPECT_EQ(expected, result.ok_value());
+    EXPECT_EQ("100000 * X^2 - 100000 = 0", parser.reduced_form());
+}
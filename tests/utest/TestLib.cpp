@@ -1,6 +1,11 @@
 #include "TestParser.hpp"
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <random>
+#include <utility>
 #include "gtest/gtest.h"
 
 TEST(TestLib, TestSqrt) {
@@ -37,6 +42,49 @@ TEST(TestLib, TestSqrt) {
     ASSERT_THROW(Computor::sqrt(std::numeric_limits<double>::lowest()), std::domain_error);
 }
 
+// 指数部の全域 (subnormalを含む) で誤差は1ulp以内
+TEST(TestLib, TestSqrtRange) {
+    std::mt19937_64 engine(42);
+    const std::uint64_t kInfBits = 0x7FF0000000000000;
+
+    for (int i = 0; i < 100000; ++i) {
+        double num = std::bit_cast<double>(engine() % kInfBits);
+        double expected = std::sqrt(num);
+        double actual = Computor::sqrt(num);
+        std::uint64_t expected_bits = std::bit_cast<std::uint64_t>(expected);
+        std::uint64_t actual_bits = std::bit_cast<std::uint64_t>(actual);
+        EXPECT_LE(std::max(expected_bits, actual_bits) - std::min(expected_bits, actual_bits), 1u)
+            << "num: " << num;
+    }
+
+    double num = std::numeric_limits<double>::denorm_min();
+    EXPECT_DOUBLE_EQ(std::sqrt(num), Computor::sqrt(num));
+    EXPECT_EQ(-0.0, Computor::sqrt(-0.0));
+}
+
+TEST(TestLib, TestTrySqrt) {
+    std::pair<Computor::Status, double> result;
+
+    result = Computor::try_sqrt(4.0);
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_EQ(2.0, result.second);
+
+    result = Computor::try_sqrt(0.0);
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_EQ(0.0, result.second);
+
+    result = Computor::try_sqrt(std::numeric_limits<double>::max());
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_DOUBLE_EQ(std::sqrt(std::numeric_limits<double>::max()), result.second);
+
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(-1).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(-std::numeric_limits<double>::min()).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(std::numeric_limits<double>::lowest()).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(std::numeric_limits<double>::quiet_NaN()).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(std::numeric_limits<double>::infinity()).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::try_sqrt(-std::numeric_limits<double>::infinity()).first);
+}
+
 TEST(TestLib, TestIsNan) {
     double num;
 
@@ -92,3 +140,63 @@ TEST(TestLib, TestIsInf) {
     num = std::numeric_limits<double>::quiet_NaN();
     EXPECT_EQ(std::isnan(num), Computor::isnan(num));
 }
+
+TEST(TestLib, TestStod) {
+    std::pair<Computor::Status, double> result;
+    std::string Ep308 = "1" + std::string(308, '0');
+    std::string Ep309 = "1" + std::string(309, '0');
+    std::string Em308 = "0." + std::string(307, '0') + "1";
+
+    std::deque<std::string> words = {
+            "0", "1", "42", "0.5", "9.3", "007", "123.456", "2147483648",
+            "3.14159265358979323846264338327950288419716939937510",
+            "0.0000000000000000000000000000000000000000000000001",
+            "123456789012345678901234567890.123456789012345678901234567890",
+            Ep308,
+    };
+    for (const auto &word : words) {
+        result = Computor::stod(word);
+        EXPECT_EQ(Computor::SUCCESS, result.first) << word;
+        EXPECT_EQ(std::stod(word), result.second) << word;
+    }
+
+    // overflow, subnormal
+    EXPECT_EQ(Computor::FAILURE, Computor::stod(Ep309).first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod(Em308).first);
+
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("-1").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("+1").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod(" 1").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("1 ").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("1e3").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("1.2.3").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("1X").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("inf").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("nan").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stod("\xff""1").first);
+}
+
+TEST(TestLib, TestStoi) {
+    std::pair<Computor::Status, std::int32_t> result;
+
+    result = Computor::stoi("0");
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_EQ(0, result.second);
+
+    result = Computor::stoi("002");
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_EQ(2, result.second);
+
+    result = Computor::stoi("2147483647");
+    EXPECT_EQ(Computor::SUCCESS, result.first);
+    EXPECT_EQ(std::numeric_limits<std::int32_t>::max(), result.second);
+
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("2147483648").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("99999999999999999999").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("-1").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("1.0").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("1 ").first);
+    EXPECT_EQ(Computor::FAILURE, Computor::stoi("\xff""1").first);
+}
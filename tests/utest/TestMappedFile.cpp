@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "MappedFile.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::string write_tmp_file(const std::string &name, const std::string &content) {
+    std::string path = ::testing::TempDir() + name;
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << content;
+    return path;
+}
+
+}  // namespace
+
+TEST(TestMappedFile, TestOpen) {
+    MappedFile file;
+    Result<Computor::Status, ErrMsg> result;
+    std::string path;
+
+    path = write_tmp_file("computor_mapped.txt", "5 * X^0 + 4 * X^1 = 4 * X^0\n");
+    result = file.open(path);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_EQ("5 * X^0 + 4 * X^1 = 4 * X^0\n", file.data());
+    EXPECT_EQ("5 * X^0 + 4 * X^1 = 4 * X^0", Computor::trim_newline(file.data()));
+    std::remove(path.c_str());
+
+    path = write_tmp_file("computor_empty.txt", "");
+    result = file.open(path);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_TRUE(file.data().empty());
+    std::remove(path.c_str());
+
+    result = file.open(::testing::TempDir() + "computor_not_exist.txt");
+    EXPECT_TRUE(result.is_err());
+    EXPECT_TRUE(file.data().empty());
+
+    result = file.open(::testing::TempDir());
+    EXPECT_TRUE(result.is_err());
+}
+
+TEST(TestMappedFile, TestCalcEquationFile) {
+    std::stringstream captured_cout, captured_cerr;
+    std::streambuf *old_cout = std::cout.rdbuf(captured_cout.rdbuf());
+    std::streambuf *old_cerr = std::cerr.rdbuf(captured_cerr.rdbuf());
+
+    std::string path = write_tmp_file("computor_equation.txt", "5 * X^0 + 4 * X^1 = 4 * X^0\r\n");
+    int result = Computor::calc_equation_file(path);
+    std::remove(path.c_str());
+
+    path = ::testing::TempDir() + "computor_not_exist.txt";
+    int err_result = Computor::calc_equation_file(path);
+
+    std::cout.rdbuf(old_cout);
+    std::cerr.rdbuf(old_cerr);
+
+    EXPECT_EQ(EXIT_SUCCESS, result);
+    EXPECT_EQ(EXIT_FAILURE, err_result);
+    EXPECT_EQ("Reduced form     : 4 * X + 1 = 0\n"
+              "Polynomial degree: 1\n"
+              "The solution is:\n"
+              "-0.25\n", captured_cout.str());
+    EXPECT_EQ("[Error] cannot open file: " + path + ": No such file or directory\n",
+              captured_cerr.str());
+}
@@ -0,0 +1,79 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include "OutputBuffer.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::string stream_double(double num) {
+    std::ostringstream out;
+    out << num;
+    return out.str();
+}
+
+std::string buffer_double(double num) {
+    OutputBuffer buffer;
+    buffer.append(num);
+    return std::string(buffer.view());
+}
+
+}  // namespace
+
+TEST(TestOutputBuffer, TestAppend) {
+    OutputBuffer buffer;
+
+    EXPECT_TRUE(buffer.empty());
+    buffer.append("Polynomial degree: ");
+    buffer.append(static_cast<std::int32_t>(-2147483647 - 1));
+    buffer.append('\n');
+    EXPECT_EQ("Polynomial degree: -2147483648\n", buffer.view());
+    EXPECT_EQ(31u, buffer.size());
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ("", buffer.view());
+}
+
+// std::ostreamの既定の書式と同じ文字列になる
+TEST(TestOutputBuffer, TestDoubleSameAsStream) {
+    const double values[] = {
+            0.0, -0.0, 1.0, -1.0, 0.5, 9.3, 0.905239, -0.475131, 1.0 / 3.0,
+            123456.0, 1234567.0, 999999.5, 0.0001, 0.00001, 1e-08, 1e+100, -1e-300,
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::min(),
+            std::numeric_limits<double>::denorm_min(),
+            std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::quiet_NaN(),
+    };
+    for (double value : values) {
+        EXPECT_EQ(stream_double(value), buffer_double(value)) << value;
+    }
+
+    std::mt19937_64 engine(42);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-320, 300);
+    for (int i = 0; i < 100000; ++i) {
+        double value = mantissa(engine) * std::pow(10.0, exponent(engine));
+        ASSERT_EQ(stream_double(value), buffer_double(value)) << value;
+    }
+}
+
+// write_toは内容を1回で書き込み、clearする. capacityは再利用する
+TEST(TestOutputBuffer, TestWriteTo) {
+    OutputBuffer buffer;
+    std::ostringstream out;
+
+    buffer.append("a\n");
+    buffer.append(1.5);
+    buffer.write_to(out);
+    EXPECT_TRUE(buffer.empty());
+    buffer.append("b");
+    buffer.write_to(out);
+    buffer.write_to(out);
+    EXPECT_EQ("a\n1.5b", out.str());
+}
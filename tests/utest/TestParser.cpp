@@ -1,4 +1,5 @@
 #include "TestParser.hpp"
+#include <random>
 #include "Result.hpp"
 #include "gtest/gtest.h"
 
@@ -878,3 +879,76 @@ TEST(TestParser, TestErrorEquation) {
 
     equation = "X^2 + 0*Y^1 + 0*X^1 = 0";
 }
+
+
+// recognize_equation()はtokenize -> parse_equation()と同じ入力を受理し、同じ多項式を得ること
+TEST(TestParser, TestRecognizeSameAsParseEquation) {
+    std::mt19937 engine(42);
+    std::string charset = "0123456789.+-*=^   xXY#";
+    std::deque<std::string> equations = {
+            "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+            "5 * X^0 + 4 * X^1 = 4 * X^0",
+            "2X^2 + 1 = 0",
+            "2X^2X = 0",
+            "2.5X = X^0",
+            "-X = +2x",
+            "X^0 + Y = 0",
+            "0*Y^0 + X = 0",
+            "X + 2 = 1 * Y",
+            "2XY = 0",
+            "2. X = 0",
+            "2.X = 0",
+            "X^2.0 = 0",
+            "X^-1 = 0",
+            "X^2147483647 = 0",
+            "X^2147483648 = 0",
+            "X = " + std::string(309, '1'),
+            "X = 0." + std::string(307, '0') + "1",
+            "X = X\n",
+            "",
+            " ",
+            "=",
+            "X =",
+            "X = 1 = 1",
+            "* X = 1",
+            "X * 2 = 1",
+            "2 * * X = 1",
+    };
+    for (int i = 0; i < 2000; ++i) {
+        std::string equation;
+        std::size_t len = engine() % 40;
+        for (std::size_t j = 0; j < len; ++j) {
+            equation += charset[engine() % charset.size()];
+        }
+        equations.push_back(equation);
+    }
+    const char *terms[] = {"2", "X", "2X", "2.5 * X^2", "X^0", "0.5X^12", "3 * X", "x"};
+    for (int i = 0; i < 500; ++i) {
+        std::string equation = terms[engine() % 8];
+        std::size_t term_count = engine() % 8;
+        for (std::size_t j = 0; j < term_count; ++j) {
+            equation += (j == term_count / 2) ? " = " : (engine() % 2 ? " + " : "-");
+            equation += terms[engine() % 8];
+        }
+        equations.push_back(equation);
+    }
+
+    for (const auto &equation : equations) {
+        Tokenizer tokenizer;
+        Parser parser, recognizer;
+
+        Result<Computor::Status, ErrMsg> lex_result = tokenizer.lex(equation);
+        Result<Polynomials, ErrMsg> parse_result;
+        if (lex_result.is_ok()) {
+            parse_result = parser.parse_equation(tokenizer.token_stream());
+        }
+        bool expected = lex_result.is_ok() && parse_result.is_ok();
+
+        Computor::Status actual = recognizer.recognize_equation(equation);
+        ASSERT_EQ(expected, actual == Computor::Status::SUCCESS) << "[" << equation << "]";
+        if (expected) {
+            EXPECT_EQ(parse_result.ok_value(), recognizer.polynomial()) << equation;
+            EXPECT_EQ(parser.reduced_form(), recognizer.reduced_form()) << equation;
+        }
+    }
+}
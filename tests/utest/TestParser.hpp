@@ -11,9 +11,17 @@ class TestParser : public ::testing::Test {
         return Parser::skip_sp(str, start_pos, end_pos);
     }
 
+    // [current, end)をTokenStreamに変換してparse_termし、消費したtoken数だけcurrentを進める
     static Result<s_term, Computor::Status> parse_term(
             std::deque<s_token>::const_iterator *current,
             std::deque<s_token>::const_iterator &end) noexcept(true) {
-        return Parser::parse_term(current, end);
+        std::pmr::string source;
+        TokenStream stream;
+        std::size_t idx = 0;
+
+        stream.assign(std::deque<s_token>(*current, end), &source);
+        Result<s_term, Computor::Status> result = Parser::parse_term(stream, &idx);
+        std::advance(*current, idx);
+        return result;
     }
 };
@@ -0,0 +1,151 @@
+#include <sstream>
+#include <string>
+#include "Pipeline.hpp"
+#include "SolutionCache.hpp"
+#include "gtest/gtest.h"
+
+TEST(TestPipeline, TestBatch) {
+    std::istringstream in("5 * X^0 + 4 * X^1 = 4 * X^0\n"
+                          "X + Y = 0\r\n"
+                          "\n"
+                          "X^2 = 1\n"
+                          "X^0 = X^0");
+    std::ostringstream out;
+
+    int result = Computor::calc_equation_batch(in, out);
+
+    EXPECT_EQ(EXIT_SUCCESS, result);
+    EXPECT_EQ("Equation         : 5 * X^0 + 4 * X^1 = 4 * X^0\n"
+              "Reduced form     : 4 * X + 1 = 0\n"
+              "Polynomial degree: 1\n"
+              "The solution is:\n"
+              "-0.25\n"
+              "Status           : 0\n"
+              "Equation         : X + Y = 0\n"
+              "[Error] syntax error: unexpected token near: Y\n"
+              "Status           : 1\n"
+              "Equation         : \n"
+              "[Error] invalid equation\n"
+              "Status           : 1\n"
+              "Equation         : X^2 = 1\n"
+              "Reduced form     : 1 * X^2 - 1 = 0\n"
+              "Polynomial degree: 2\n"
+              "Discriminant is positive, the two solutions are:\n"
+              " 1\n"
+              "-1\n"
+              "Status           : 0\n"
+              "Equation         : X^0 = X^0\n"
+              "Reduced form     : 0 = 0\n"
+              "Polynomial degree: 0\n"
+              "The equation is indeterminate, infinite solutions.\n"
+              "Status           : 1\n", out.str());
+}
+
+TEST(TestPipeline, TestReuse) {
+    Pipeline pipeline;
+    std::ostringstream out, err;
+
+    // 前の方程式の変数 (y) を引き継がないこと
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("y = 1", out, err));
+    out.str("");
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("x^2 = 1", out, err));
+    EXPECT_EQ("Reduced form     : 1 * x^2 - 1 = 0\n"
+              "Polynomial degree: 2\n"
+              "Discriminant is positive, the two solutions are:\n"
+              " 1\n"
+              "-1\n", out.str());
+    EXPECT_EQ("", err.str());
+}
+
+// 簡約後の多項式が同じ方程式はcacheの解を使う
+TEST(TestPipeline, TestSolutionCache) {
+    SolutionCache cache(16);
+    Pipeline pipeline;
+    pipeline.set_solution_cache(&cache);
+    std::ostringstream first, second, err;
+
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("x^2 = 1", first, err));
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("2x^2 - 1 = x^2", second, err));
+    EXPECT_EQ(first.str(), second.str());
+    EXPECT_EQ(1u, cache.hits());
+    EXPECT_EQ(1u, cache.misses());
+
+    // 解なしの結果もcacheする
+    EXPECT_EQ(EXIT_FAILURE, pipeline.run("x^0 = 2", first, err));
+    EXPECT_EQ(EXIT_FAILURE, pipeline.run("x^0 = 2", second, err));
+    EXPECT_EQ(2u, cache.hits());
+    EXPECT_EQ("", err.str());
+}
+
+// threads数によらず、出力はthreads = 1と同じ (入力順)
+TEST(TestPipeline, TestBatchThreads) {
+    const char *equations[] = {
+            "5 * X^0 + 4 * X^1 = 4 * X^0",
+            "X^2 + 2 * X + 5 = 0",
+            "X + Y = 0",
+            "",
+            "X^2 = 1",
+            "X^0 = X^0",
+            "3 = 0",
+            "x^3 + 1 = 0",
+    };
+    std::string input;
+    for (int i = 0; i < 3000; ++i) {
+        input += equations[i % 8];
+        input += (i % 3 == 0) ? "\r\n" : "\n";
+    }
+
+    std::istringstream expected_in(input);
+    std::ostringstream expected;
+    ASSERT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(expected_in, expected));
+
+    for (std::size_t threads : {2, 3, 8}) {
+        std::istringstream in(input);
+        std::ostringstream out;
+
+        EXPECT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(in, out, {.threads = threads}));
+        EXPECT_EQ(expected.str(), out.str()) << "threads: " << threads;
+    }
+}
+
+// cacheの有無、thread数によらず出力は同じ
+TEST(TestPipeline, TestBatchCache) {
+    const char *equations[] = {
+            "X^2 + 2 * X + 5 = 0",
+            "2 * X^2 + 4 * X + 10 = X^2 + 2 * X + 5",
+            "X^2 = 1",
+            "X^2 - 1 = 0",
+            "x^3 + 1 = 0",
+            "X + Y = 0",
+            "3 = 0",
+    };
+    std::string input;
+    for (int i = 0; i < 2000; ++i) {
+        input += equations[(i * 5) % 7];
+        input += "\n";
+    }
+
+    std::istringstream expected_in(input);
+    std::ostringstream expected;
+    ASSERT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(expected_in, expected));
+
+    for (std::size_t threads : {1, 4}) {
+        for (std::size_t capacity : {1, 2, 1024}) {
+            std::istringstream in(input);
+            std::ostringstream out;
+
+            Computor::s_batch_options options = {.threads = threads, .cache_capacity = capacity};
+            EXPECT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(in, out, options));
+            EXPECT_EQ(expected.str(), out.str())
+                    << "threads: " << threads << ", capacity: " << capacity;
+        }
+    }
+}
+
+TEST(TestPipeline, TestBatchThreadsEmpty) {
+    std::istringstream in("");
+    std::ostringstream out;
+
+    EXPECT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(in, out, {.threads = 4}));
+    EXPECT_EQ("", out.str());
+}
@@ -0,0 +1,129 @@
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Polynomial.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+void expect_same_terms(
+        const std::map<std::int32_t, double> &expected,
+        const Polynomial &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_EQ(expected.empty(), actual.empty());
+
+    std::vector<std::pair<std::int32_t, double>> forward, backward;
+    for (const auto &term : actual) {
+        forward.emplace_back(term.first, term.second);
+    }
+    for (auto itr = actual.crbegin(); itr != actual.crend(); ++itr) {
+        backward.emplace(backward.begin(), itr->first, itr->second);
+    }
+    std::vector<std::pair<std::int32_t, double>> expected_terms(expected.begin(), expected.end());
+    EXPECT_EQ(expected_terms, forward);
+    EXPECT_EQ(expected_terms, backward);
+    std::map<std::int32_t, double> converted = actual;
+    EXPECT_EQ(expected, converted);
+}
+
+}  // namespace
+
+TEST(TestPolynomial, TestDenseAndSparse) {
+    Polynomial polynomial;
+    EXPECT_TRUE(polynomial.empty());
+    EXPECT_TRUE(polynomial.begin() == polynomial.end());
+    EXPECT_TRUE(polynomial.crbegin() == polynomial.crend());
+
+    polynomial[2] += 1.5;
+    polynomial[0] -= 3.0;
+    polynomial[100] = 7.0;
+    polynomial[15] = 2.0;
+    polynomial[16] = 4.0;
+    polynomial[-1] = 5.0;
+    expect_same_terms({{-1, 5.0}, {0, -3.0}, {2, 1.5}, {15, 2.0}, {16, 4.0}, {100, 7.0}},
+                      polynomial);
+
+    EXPECT_EQ(1.5, polynomial.at(2));
+    EXPECT_EQ(7.0, polynomial.at(100));
+    EXPECT_THROW(polynomial.at(1), std::out_of_range);
+    EXPECT_THROW(polynomial.at(17), std::out_of_range);
+    EXPECT_TRUE(polynomial.find(1) == polynomial.end());
+    EXPECT_EQ(2, polynomial.find(2)->first);
+    EXPECT_EQ(16, polynomial.find(16)->first);
+    EXPECT_EQ(100, polynomial.crbegin()->first);
+    EXPECT_EQ(-1, polynomial.begin()->first);
+
+    // std::map::operator[]と同じく、参照のみでも項は追加される
+    EXPECT_EQ(0.0, polynomial[3]);
+    EXPECT_EQ(7u, polynomial.size());
+
+    polynomial.erase(polynomial.find(3));
+    polynomial.erase(polynomial.find(-1));
+    polynomial.erase(polynomial.find(16));
+    expect_same_terms({{0, -3.0}, {2, 1.5}, {15, 2.0}, {100, 7.0}}, polynomial);
+
+    Polynomial copied(polynomial);
+    EXPECT_TRUE(copied == polynomial);
+    copied[0] = 1.0;
+    EXPECT_FALSE(copied == polynomial);
+    copied = polynomial;
+    EXPECT_TRUE(copied == polynomial);
+
+    polynomial.clear();
+    EXPECT_TRUE(polynomial.empty());
+    expect_same_terms({}, polynomial);
+
+    Polynomial initialized = {{0, 1.0}, {2, -1.0}, {20, 3.0}};
+    expect_same_terms({{0, 1.0}, {2, -1.0}, {20, 3.0}}, initialized);
+}
+
+// arenaの多項式のmoveは既定のresourceへnodeを確保し直す (例外を投げうるためnoexceptではない)
+TEST(TestPolynomial, TestMoveAcrossResources) {
+    EXPECT_FALSE(std::is_nothrow_move_constructible_v<Polynomial>);
+    EXPECT_FALSE(std::is_nothrow_move_assignable_v<Polynomial>);
+
+    std::pmr::monotonic_buffer_resource arena;
+    Polynomial source(&arena);
+    source[1] = 2.0;
+    source[20] = 3.0;
+    source[-2] = 4.0;
+
+    Polynomial moved(std::move(source));
+    expect_same_terms({{-2, 4.0}, {1, 2.0}, {20, 3.0}}, moved);
+
+    Polynomial assigned;
+    Polynomial other(&arena);
+    other[30] = 5.0;
+    assigned = std::move(other);
+    expect_same_terms({{30, 5.0}}, assigned);
+}
+
+TEST(TestPolynomial, TestSameAsMap) {
+    std::mt19937 engine(42);
+
+    for (int i = 0; i < 200; ++i) {
+        std::map<std::int32_t, double> expected;
+        Polynomial actual;
+
+        for (int j = 0; j < 50; ++j) {
+            std::int32_t degree = static_cast<std::int32_t>(engine() % 40) - 4;
+            double coef = static_cast<double>(engine() % 5) - 2.0;
+            expected[degree] += coef;
+            actual[degree] += coef;
+        }
+        expect_same_terms(expected, actual);
+
+        // drop zero term
+        for (auto itr = expected.begin(); itr != expected.end();) {
+            itr = itr->second == 0.0 ? expected.erase(itr) : std::next(itr);
+        }
+        for (auto itr = actual.begin(); itr != actual.end();) {
+            itr = itr->second == 0.0 ? actual.erase(itr) : std::next(itr);
+        }
+        expect_same_terms(expected, actual);
+    }
+}
@@ -0,0 +1,153 @@
+#include <bit>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "Pipeline.hpp"
+#include "RecordFormatter.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::uint32_t read_u32(const std::string &bytes, std::size_t offset) {
+    std::uint32_t num = 0;
+    for (int i = 0; i < 4; ++i) {
+        num |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+    }
+    return num;
+}
+
+double read_f64(const std::string &bytes, std::size_t offset) {
+    std::uint64_t num = 0;
+    for (int i = 0; i < 8; ++i) {
+        num |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+    }
+    return std::bit_cast<double>(num);
+}
+
+std::string batch(const std::string &input, Computor::OutputFormat format, std::size_t threads) {
+    std::istringstream in(input);
+    std::ostringstream out;
+    Computor::s_batch_options options = {.threads = threads, .format = format};
+    EXPECT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(in, out, options));
+    return out.str();
+}
+
+}  // namespace
+
+TEST(TestRecordFormatter, TestJson) {
+    OutputBuffer out;
+
+    Polynomials polynomial{{2, 1.0}, {0, -1.0}};
+    EXPECT_EQ(EXIT_SUCCESS, Pipeline::solve_record("x^2 = 1", polynomial, Computor::JSON, &out));
+    EXPECT_EQ("{\"equation\":\"x^2 = 1\",\"status\":0,\"degree\":2,"
+              "\"terms\":[{\"degree\":2,\"coefficient\":1},{\"degree\":0,\"coefficient\":-1}],"
+              "\"type\":\"TwoRealSolutionsQuadratic\","
+              "\"solutions\":[{\"re\":1,\"im\":0},{\"re\":-1,\"im\":0}]}\n", out.view());
+
+    // 数値は往復変換できる最短表記 (表示用の6桁に丸めない)
+    out.clear();
+    Polynomials linear{{1, 3.0}, {0, -1.0}};
+    EXPECT_EQ(EXIT_SUCCESS, Pipeline::solve_record("3x = 1", linear, Computor::JSON, &out));
+    EXPECT_NE(std::string::npos, out.view().find("{\"re\":0.3333333333333333,\"im\":0}"));
+
+    out.clear();
+    Polynomials indeterminate{{0, 0.0}};
+    EXPECT_EQ(EXIT_FAILURE, Pipeline::solve_record("0 = 0", indeterminate, Computor::JSON, &out));
+    EXPECT_EQ("{\"equation\":\"0 = 0\",\"status\":1,\"degree\":0,"
+              "\"terms\":[{\"degree\":0,\"coefficient\":0}],"
+              "\"type\":\"Indeterminate\",\"solutions\":[]}\n", out.view());
+}
+
+TEST(TestRecordFormatter, TestJsonError) {
+    OutputBuffer out;
+
+    EXPECT_EQ(EXIT_FAILURE, Pipeline::error_record(
+            "x \"+\\\t", "syntax error", Computor::JSON, &out));
+    EXPECT_EQ("{\"equation\":\"x \\\"+\\\\\\u0009\",\"status\":1,"
+              "\"error\":\"syntax error\"}\n", out.view());
+}
+
+TEST(TestRecordFormatter, TestBinary) {
+    OutputBuffer out;
+
+    Polynomials polynomial{{2, 1.0}, {0, 1.0}};
+    EXPECT_EQ(EXIT_SUCCESS, Pipeline::solve_record("x^2 = -1", polynomial, Computor::BINARY, &out));
+    std::string bytes(out.view());
+
+    // 32 + 16 * 2 (terms) + 16 * 2 (solutions) + 8 (equation) = 104
+    ASSERT_EQ(104u, bytes.size());
+    EXPECT_EQ(104u, read_u32(bytes, 0));
+    EXPECT_EQ(0u, read_u32(bytes, 4));
+    EXPECT_EQ(2u, read_u32(bytes, 8));
+    EXPECT_EQ(static_cast<std::uint32_t>(QuadraticSolver::TwoComplexSolutionsQuadratic),
+              read_u32(bytes, 12));
+    EXPECT_EQ(2u, read_u32(bytes, 16));
+    EXPECT_EQ(2u, read_u32(bytes, 20));
+    EXPECT_EQ(8u, read_u32(bytes, 24));
+    EXPECT_EQ(0u, read_u32(bytes, 28));
+
+    EXPECT_EQ(2u, read_u32(bytes, 32));
+    EXPECT_EQ(1.0, read_f64(bytes, 40));
+    EXPECT_EQ(0u, read_u32(bytes, 48));
+    EXPECT_EQ(1.0, read_f64(bytes, 56));
+
+    EXPECT_EQ(0.0, read_f64(bytes, 64));
+    EXPECT_EQ(1.0, read_f64(bytes, 72));
+    EXPECT_EQ(0.0, read_f64(bytes, 80));
+    EXPECT_EQ(-1.0, read_f64(bytes, 88));
+    EXPECT_EQ("x^2 = -1", bytes.substr(96, 8));
+}
+
+TEST(TestRecordFormatter, TestBinaryError) {
+    OutputBuffer out;
+
+    EXPECT_EQ(EXIT_FAILURE, Pipeline::error_record("x +", "syntax error", Computor::BINARY, &out));
+    std::string bytes(out.view());
+
+    // 32 + 3 + 12 = 47 -> 8byte境界の48
+    ASSERT_EQ(48u, bytes.size());
+    EXPECT_EQ(48u, read_u32(bytes, 0));
+    EXPECT_EQ(1u, read_u32(bytes, 4));
+    EXPECT_EQ(0xFFFFFFFFu, read_u32(bytes, 8));
+    EXPECT_EQ(RecordFormatter::kBinaryNoSolutionType, read_u32(bytes, 12));
+    EXPECT_EQ(0u, read_u32(bytes, 16));
+    EXPECT_EQ(0u, read_u32(bytes, 20));
+    EXPECT_EQ(3u, read_u32(bytes, 24));
+    EXPECT_EQ(12u, read_u32(bytes, 28));
+    EXPECT_EQ("x +syntax error", bytes.substr(32, 15));
+    EXPECT_EQ('\0', bytes[47]);
+}
+
+// thread数によらず、入力順に同じrecordが並ぶ
+TEST(TestRecordFormatter, TestBatch) {
+    std::string input;
+    for (int i = 0; i < 300; ++i) {
+        input += (i % 7 == 0) ? "x + y = 0\n" : std::to_string(i) + " * x^2 - x = 1\n";
+    }
+
+    for (Computor::OutputFormat format : {Computor::JSON, Computor::BINARY}) {
+        std::string expected = batch(input, format, 1);
+        EXPECT_EQ(expected, batch(input, format, 4));
+
+        // 1方程式1record
+        std::size_t records = 0;
+        if (format == Computor::JSON) {
+            for (char c : expected) {
+                records += (c == '\n') ? 1 : 0;
+            }
+        } else {
+            std::size_t offset = 0;
+            while (offset < expected.size()) {
+                std::uint32_t size = read_u32(expected, offset);
+                ASSERT_EQ(0u, size % RecordFormatter::kBinaryAlignment);
+                offset += size;
+                ++records;
+            }
+        }
+        EXPECT_EQ(300u, records);
+    }
+
+    EXPECT_EQ("{\"equation\":\"x + y = 0\",\"status\":1,"
+              "\"error\":\"syntax error: unexpected token near: y\"}\n",
+              batch("x + y = 0\n", Computor::JSON, 1));
+}
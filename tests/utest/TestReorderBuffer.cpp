@@ -0,0 +1,39 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include "ReorderBuffer.hpp"
+#include "gtest/gtest.h"
+
+TEST(TestReorderBuffer, TestTakeInOrder) {
+    ReorderBuffer buffer;
+
+    buffer.put(2, "c");
+    buffer.put(0, "a");
+    buffer.put(1, "b");
+
+    EXPECT_EQ(0, buffer.next_sequence());
+    EXPECT_EQ("a", buffer.take());
+    EXPECT_EQ("b", buffer.take());
+    EXPECT_EQ("c", buffer.take());
+    EXPECT_EQ(3, buffer.next_sequence());
+}
+
+// 次のsequenceがputされるまでtakeは待つ
+TEST(TestReorderBuffer, TestTakeWaitsForNext) {
+    ReorderBuffer buffer;
+    std::vector<std::thread> writers;
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        writers.emplace_back([&buffer, i] {
+            buffer.put(7 - i, std::to_string(7 - i));
+        });
+    }
+    std::string result;
+    for (int i = 0; i < 8; ++i) {
+        result += buffer.take();
+    }
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ("01234567", result);
+}
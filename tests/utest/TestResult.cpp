@@ -0,0 +1,93 @@
+#include <deque>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Result.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// default constructibleでない型
+struct s_no_default {
+    explicit s_no_default(int value) : value(value) {}
+    int value;
+};
+
+}  // namespace
+
+TEST(TestResult, TestOkErr) {
+    Result<int, std::string> result;
+    EXPECT_TRUE(result.is_err());
+
+    result = Result<int, std::string>::ok(42);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_FALSE(result.is_err());
+    EXPECT_EQ(42, result.ok_value());
+    EXPECT_THROW(result.err_value(), std::runtime_error);
+
+    result = Result<int, std::string>::err("error");
+    EXPECT_FALSE(result.is_ok());
+    EXPECT_TRUE(result.is_err());
+    EXPECT_EQ("error", result.err_value());
+    EXPECT_THROW(result.ok_value(), std::runtime_error);
+
+    // OkTypeとErrTypeが同じ型
+    Result<std::string, std::string> same = Result<std::string, std::string>::err("error");
+    EXPECT_TRUE(same.is_err());
+    EXPECT_EQ("error", same.err_value());
+    same = Result<std::string, std::string>::ok("ok");
+    EXPECT_TRUE(same.is_ok());
+    EXPECT_EQ("ok", same.ok_value());
+}
+
+TEST(TestResult, TestMoveOut) {
+    std::map<int, double> polynomial = {{0, 1.0}, {2, -3.0}};
+    Result<std::map<int, double>, std::string> result;
+
+    result = Result<std::map<int, double>, std::string>::ok(polynomial);
+    const double *coef = &result.ok_value().at(0);
+    std::map<int, double> moved = std::move(result).ok_value();
+    EXPECT_EQ(polynomial, moved);
+    EXPECT_EQ(coef, &moved.at(0));  // node is moved, not copied
+
+    // 参照を返す
+    result = Result<std::map<int, double>, std::string>::ok(polynomial);
+    result.ok_value()[1] = 5.0;
+    EXPECT_EQ(5.0, result.ok_value().at(1));
+
+    // move only
+    Result<std::unique_ptr<int>, std::string> ptr_result;
+    ptr_result = Result<std::unique_ptr<int>, std::string>::ok(std::make_unique<int>(42));
+    std::unique_ptr<int> ptr = std::move(ptr_result).ok_value();
+    EXPECT_EQ(42, *ptr);
+}
+
+TEST(TestResult, TestNoDefaultConstructible) {
+    Result<s_no_default, s_no_default> result = Result<s_no_default, s_no_default>::ok(
+            s_no_default(1));
+    EXPECT_EQ(1, result.ok_value().value);
+
+    Result<s_no_default, s_no_default> copied(result);
+    EXPECT_EQ(1, copied.ok_value().value);
+
+    result = Result<s_no_default, s_no_default>::err(s_no_default(2));
+    EXPECT_TRUE(result.is_err());
+    EXPECT_EQ(2, result.err_value().value);
+}
+
+// moveのnoexceptはOkType, ErrTypeのmoveに従う
+TEST(TestResult, TestNothrowMove) {
+    using IntResult = Result<int, std::string>;
+    using DequeResult = Result<std::deque<int>, std::string>;
+
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<IntResult>);
+    EXPECT_TRUE(std::is_nothrow_move_assignable_v<IntResult>);
+    EXPECT_EQ(std::is_nothrow_move_constructible_v<std::deque<int>>,
+              std::is_nothrow_move_constructible_v<DequeResult>);
+    EXPECT_EQ(std::is_nothrow_move_assignable_v<std::deque<int>>
+              && std::is_nothrow_move_constructible_v<std::deque<int>>,
+              std::is_nothrow_move_assignable_v<DequeResult>);
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+#include "RootFinder.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// |p(z)| / sum |c_i| |z|^i (後退誤差)
+// |z| > 1 では係数を逆順にした多項式を1 / zで評価する (比は z^n 倍しても変わらない)
+double backward_error(const std::vector<double> &coefficients, std::complex<double> z) {
+    std::vector<double> c = coefficients;
+    if (1.0 < std::abs(z)) {
+        std::reverse(c.begin(), c.end());
+        z = 1.0 / z;
+    }
+    std::complex<double> p = 0.0;
+    double bound = 0.0;
+    for (std::size_t i = c.size(); 0 < i; --i) {
+        p = p * z + c[i - 1];
+        bound = bound * std::abs(z) + std::abs(c[i - 1]);
+    }
+    return std::abs(p) / bound;
+}
+
+std::vector<double> sorted_real_parts(const std::vector<std::complex<double>> &roots) {
+    std::vector<double> real_parts;
+    for (const std::complex<double> &root : roots) {
+        real_parts.push_back(root.real());
+    }
+    std::sort(real_parts.begin(), real_parts.end());
+    return real_parts;
+}
+
+}  // namespace
+
+TEST(TestRootFinder, TestRealRoots) {
+    RootFinder root_finder;
+
+    // (x - 1)(x - 2)(x - 3)
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({-6, 11, -6, 1}));
+    std::vector<double> real_parts = sorted_real_parts(root_finder.roots());
+    ASSERT_EQ(3u, real_parts.size());
+    EXPECT_NEAR(1.0, real_parts[0], 1e-12);
+    EXPECT_NEAR(2.0, real_parts[1], 1e-12);
+    EXPECT_NEAR(3.0, real_parts[2], 1e-12);
+    for (const std::complex<double> &root : root_finder.roots()) {
+        EXPECT_NEAR(0.0, root.imag(), 1e-12);
+    }
+}
+
+TEST(TestRootFinder, TestRootsOfUnity) {
+    RootFinder root_finder;
+
+    for (std::size_t degree : {3, 5, 16, 100}) {
+        std::vector<double> coefficients(degree + 1, 0.0);
+        coefficients.front() = -1.0;
+        coefficients.back() = 1.0;
+
+        ASSERT_EQ(Computor::SUCCESS, root_finder.solve(coefficients)) << "degree: " << degree;
+        ASSERT_EQ(degree, root_finder.roots().size());
+        for (const std::complex<double> &root : root_finder.roots()) {
+            EXPECT_NEAR(1.0, std::abs(root), 1e-12) << "degree: " << degree;
+        }
+    }
+}
+
+// X = 0 の解は反復せずに除く
+TEST(TestRootFinder, TestZeroRoots) {
+    RootFinder root_finder;
+
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({0, 0, 0, 1}));
+    EXPECT_EQ(std::vector<std::complex<double>>(3, 0.0), root_finder.roots());
+    EXPECT_EQ(0, root_finder.iterations());
+
+    // x^3 (x - 2)
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({0, 0, 0, -2, 1}));
+    std::vector<double> real_parts = sorted_real_parts(root_finder.roots());
+    EXPECT_EQ(0.0, real_parts[0]);
+    EXPECT_EQ(0.0, real_parts[1]);
+    EXPECT_EQ(0.0, real_parts[2]);
+    EXPECT_NEAR(2.0, real_parts[3], 1e-12);
+}
+
+// 包含円は真の解を含む. 重解の近似の半径は約sqrt(eps)で、単根より大きい
+TEST(TestRootFinder, TestRadii) {
+    RootFinder root_finder;
+
+    // (x - 1)^2 (x + 2) = x^3 - 3x + 2
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({2, -3, 0, 1}));
+    ASSERT_EQ(3u, root_finder.radii().size());
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::complex<double> root = root_finder.roots()[i];
+        double radius = root_finder.radii()[i];
+        double expected = root.real() < 0.0 ? -2.0 : 1.0;
+        EXPECT_LE(std::abs(root - expected), radius) << root;
+        if (expected == 1.0) {
+            EXPECT_LT(1e-12, radius) << root;
+            EXPECT_GT(1e-6, radius) << root;
+        } else {
+            EXPECT_GT(1e-13, radius) << root;
+        }
+    }
+
+    // X = 0 の解の半径は0
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({0, 0, -2, 1}));
+    std::size_t zero_radii = std::count(root_finder.radii().begin(),
+                                        root_finder.radii().end(), 0.0);
+    EXPECT_LE(2u, zero_radii);
+}
+
+// |c0 / cn| がunderflow, overflowする係数でも初期値は0, infにならない
+TEST(TestRootFinder, TestExtremeCoefficientRatio) {
+    RootFinder root_finder;
+
+    // 1e200 x^5 - 1e-200 -> |x| = 1e-80
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({-1e-200, 0, 0, 0, 0, 1e200}));
+    for (const std::complex<double> &root : root_finder.roots()) {
+        EXPECT_NEAR(1.0, std::abs(root) / 1e-80, 1e-12) << root;
+    }
+
+    // 1e-200 x^5 - 1e200 -> |x| = 1e80
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({-1e200, 0, 0, 0, 0, 1e-200}));
+    for (const std::complex<double> &root : root_finder.roots()) {
+        EXPECT_NEAR(1.0, std::abs(root) / 1e80, 1e-12) << root;
+    }
+}
+
+// 根の間隔の2乗がunderflowする (|z_i - z_j| < 1e-154) 場合もAberth法の補正は0, nanにならない
+TEST(TestRootFinder, TestTinyRootSpacing) {
+    RootFinder root_finder;
+
+    // 1e307 x^3 + 1e-301 -> |x| = 1e-608^(1/3)
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({1e-301, 0, 0, 1e307}));
+    const double expected = std::cbrt(1e-301) / std::cbrt(1e307);
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::complex<double> root = root_finder.roots()[i];
+        EXPECT_NEAR(1.0, std::abs(root) / expected, 1e-12) << root;
+        EXPECT_GT(1e-12 * expected, root_finder.radii()[i]) << root;
+    }
+}
+
+// 次数500, 係数の大きさが大きく異なる多項式でもoverflowせずに収束する (seed固定)
+TEST(TestRootFinder, TestHighDegree) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+
+    for (std::size_t degree : {50, 500}) {
+        std::vector<double> coefficients;
+        for (std::size_t i = 0; i <= degree; ++i) {
+            coefficients.push_back(mantissa(engine) * std::pow(10.0, exponent(engine)));
+        }
+        RootFinder root_finder;
+
+        ASSERT_EQ(Computor::SUCCESS, root_finder.solve(coefficients)) << "degree: " << degree;
+        ASSERT_EQ(degree, root_finder.roots().size());
+        for (const std::complex<double> &root : root_finder.roots()) {
+            EXPECT_LT(backward_error(coefficients, root), 1e-12) << "degree: " << degree;
+        }
+    }
+}
+
+TEST(TestRootFinder, TestConfig) {
+    s_root_finder_config config;
+    config.max_iterations = 1;
+    RootFinder root_finder(config);
+
+    EXPECT_EQ(Computor::FAILURE, root_finder.solve({-6, 11, -6, 1}));
+    EXPECT_EQ(1, root_finder.iterations());
+
+    config.max_iterations = 1000;
+    config.tolerance = 1e-3;
+    RootFinder loose(config);
+    RootFinder strict;
+    ASSERT_EQ(Computor::SUCCESS, loose.solve({-6, 11, -6, 1}));
+    ASSERT_EQ(Computor::SUCCESS, strict.solve({-6, 11, -6, 1}));
+    EXPECT_LE(loose.iterations(), strict.iterations());
+}
+
+// set_config()は次のsolve()から使い、配列のcapacityは保持する
+TEST(TestRootFinder, TestSetConfig) {
+    RootFinder root_finder;
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({-6, 11, -6, 1}));
+    const std::complex<double> *data = root_finder.roots().data();
+
+    s_root_finder_config config;
+    config.max_iterations = 1;
+    root_finder.set_config(config);
+    EXPECT_EQ(Computor::FAILURE, root_finder.solve({-6, 11, -6, 1}));
+
+    root_finder.set_config(s_root_finder_config());
+    ASSERT_EQ(Computor::SUCCESS, root_finder.solve({-6, 11, -6, 1}));
+    EXPECT_EQ(data, root_finder.roots().data());
+}
+
+// 並列 (Jacobi) の結果は逐次 (Gauss-Seidel) と許容誤差の範囲で一致し、thread数によらない (seed固定)
+TEST(TestRootFinder, TestParallel) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    const std::size_t degree = 1000;
+    std::vector<double> coefficients;
+    for (std::size_t i = 0; i <= degree; ++i) {
+        coefficients.push_back(real(engine));
+    }
+    coefficients[0] = 0.0;  // X = 0 の解を1つ含む
+
+    RootFinder sequential;
+    ASSERT_EQ(Computor::SUCCESS, sequential.solve(coefficients));
+
+    std::vector<std::complex<double>> previous;
+    for (std::size_t threads : {2, 3, 8}) {
+        s_root_finder_config config;
+        config.threads = threads;
+        config.block_roots = 64;
+        RootFinder parallel(config);
+
+        ASSERT_EQ(Computor::SUCCESS, parallel.solve(coefficients)) << "threads: " << threads;
+        ASSERT_EQ(degree, parallel.roots().size());
+        for (const std::complex<double> &root : parallel.roots()) {
+            if (root != 0.0) {
+                EXPECT_LT(backward_error(coefficients, root), 1e-12) << "threads: " << threads;
+            }
+            double distance = std::abs(root - sequential.roots().front());
+            for (const std::complex<double> &expected : sequential.roots()) {
+                distance = std::min(distance, std::abs(root - expected));
+            }
+            EXPECT_LE(distance, 1e-9 * std::max(1.0, std::abs(root))) << "threads: " << threads;
+        }
+        if (!previous.empty()) {
+            EXPECT_EQ(previous, parallel.roots()) << "threads: " << threads;
+        }
+        previous = parallel.roots();
+    }
+}
@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "SolutionCache.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+s_cached_solution make_solution(double re) {
+    return {QuadraticSolver::OneRealSolutionLinear, {{.re = re, .im = 0.0}}};
+}
+
+}  // namespace
+
+TEST(TestSolutionCache, TestFindInsert) {
+    SolutionCache cache(4);
+    s_cached_solution solution;
+
+    EXPECT_FALSE(cache.find({{1, 2.0}, {0, 1.0}}, &solution));
+    cache.insert({{1, 2.0}, {0, 1.0}}, make_solution(-0.5));
+
+    ASSERT_TRUE(cache.find({{1, 2.0}, {0, 1.0}}, &solution));
+    EXPECT_EQ(QuadraticSolver::OneRealSolutionLinear, solution.type);
+    ASSERT_EQ(1u, solution.solutions.size());
+    EXPECT_EQ(-0.5, solution.solutions[0].re);
+
+    // 係数, 次数のどちらかが異なれば別のkey
+    EXPECT_FALSE(cache.find({{1, 2.0}, {0, 1.0000000000000002}}, &solution));
+    EXPECT_FALSE(cache.find({{2, 2.0}, {0, 1.0}}, &solution));
+    EXPECT_FALSE(cache.find({{1, 2.0}}, &solution));
+
+    EXPECT_EQ(1u, cache.hits());
+    EXPECT_EQ(4u, cache.misses());
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(TestSolutionCache, TestKey) {
+    EXPECT_EQ(SolutionCache::make_key({{0, 0.0}}), SolutionCache::make_key({{0, -0.0}}));
+    EXPECT_NE(SolutionCache::make_key({{0, 1.0}}), SolutionCache::make_key({{1, 1.0}}));
+    EXPECT_NE(SolutionCache::make_key({{-1, 1.0}}), SolutionCache::make_key({{1, 1.0}}));
+    EXPECT_TRUE(SolutionCache::make_key({}).empty());
+
+    // keyを渡す版は上書きし、capacityを再利用する
+    SolutionCache::Key key;
+    SolutionCache::make_key({{0, 1.0}, {1, 2.0}, {2, 3.0}}, &key);
+    const std::uint64_t *data = key.data();
+    SolutionCache::make_key({{0, -0.0}}, &key);
+    EXPECT_EQ(SolutionCache::make_key({{0, 0.0}}), key);
+    EXPECT_EQ(data, key.data());
+
+    SolutionCache cache(4);
+    s_cached_solution solution;
+    cache.insert_by_key(key, make_solution(1.0));
+    EXPECT_TRUE(cache.find({{0, 0.0}}, &solution));
+    EXPECT_TRUE(cache.find_by_key(key, &solution));
+    EXPECT_EQ(1.0, solution.solutions[0].re);
+}
+
+// 容量を超えた場合は最も長く使われていないものを捨てる (shard 1つ)
+TEST(TestSolutionCache, TestEvictLeastRecentlyUsed) {
+    SolutionCache cache(2, 1);
+    s_cached_solution solution;
+
+    cache.insert({{0, 1.0}}, make_solution(1.0));
+    cache.insert({{0, 2.0}}, make_solution(2.0));
+    ASSERT_TRUE(cache.find({{0, 1.0}}, &solution));   // 2.0 が最も古くなる
+    cache.insert({{0, 3.0}}, make_solution(3.0));
+
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.find({{0, 1.0}}, &solution));
+    EXPECT_FALSE(cache.find({{0, 2.0}}, &solution));
+    EXPECT_TRUE(cache.find({{0, 3.0}}, &solution));
+    EXPECT_EQ(3.0, solution.solutions[0].re);
+
+    // 既にあるkeyは値を置き換える
+    cache.insert({{0, 3.0}}, make_solution(4.0));
+    EXPECT_EQ(2u, cache.size());
+    ASSERT_TRUE(cache.find({{0, 3.0}}, &solution));
+    EXPECT_EQ(4.0, solution.solutions[0].re);
+}
+
+TEST(TestSolutionCache, TestCapacity) {
+    for (std::size_t capacity : {1, 5, 16, 100}) {
+        SolutionCache cache(capacity);
+
+        for (int i = 0; i < 1000; ++i) {
+            cache.insert({{0, static_cast<double>(i)}}, make_solution(i));
+        }
+        EXPECT_EQ(capacity, cache.capacity());
+        EXPECT_LE(cache.size(), capacity) << "capacity: " << capacity;
+    }
+
+    SolutionCache disabled(0);
+    s_cached_solution solution;
+    disabled.insert({{0, 1.0}}, make_solution(1.0));
+    EXPECT_EQ(0u, disabled.size());
+    EXPECT_FALSE(disabled.find({{0, 1.0}}, &solution));
+}
+
+// 複数threadから同時にfind, insertしても、見つかった値は常にkeyに対応する
+TEST(TestSolutionCache, TestConcurrent) {
+    SolutionCache cache(64);
+    std::vector<std::thread> threads;
+    std::vector<int> errors(8, 0);
+
+    for (std::size_t t = 0; t < errors.size(); ++t) {
+        threads.emplace_back([&cache, &errors, t] {
+            s_cached_solution solution;
+            for (int i = 0; i < 5000; ++i) {
+                double key = static_cast<double>((i * 7 + t) % 128);
+                if (cache.find({{0, key}}, &solution)) {
+                    errors[t] += (solution.solutions[0].re != key);
+                } else {
+                    cache.insert({{0, key}}, make_solution(key));
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (int error : errors) {
+        EXPECT_EQ(0, error);
+    }
+    EXPECT_EQ(8u * 5000u, cache.hits() + cache.misses());
+    EXPECT_LE(cache.size(), 64u);
+}
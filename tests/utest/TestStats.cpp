@@ -0,0 +1,149 @@
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include "OutputBuffer.hpp"
+#include "Pipeline.hpp"
+#include "Stats.hpp"
+#include "gtest/gtest.h"
+
+TEST(TestStats, TestBucket) {
+    EXPECT_EQ(0u, Stats::bucket(0));
+    EXPECT_EQ(0u, Stats::bucket(1));
+    EXPECT_EQ(1u, Stats::bucket(2));
+    EXPECT_EQ(1u, Stats::bucket(3));
+    EXPECT_EQ(10u, Stats::bucket(1024));
+    EXPECT_EQ(63u, Stats::bucket(std::numeric_limits<std::uint64_t>::max()));
+
+    EXPECT_EQ(1u, Stats::bucket_upper(0));
+    EXPECT_EQ(2047u, Stats::bucket_upper(10));
+    EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), Stats::bucket_upper(63));
+}
+
+TEST(TestStats, TestHistogram) {
+    Stats stats;
+
+    // 空のhistogram
+    EXPECT_EQ(0u, stats.stage(Stats::Solve).count);
+    EXPECT_EQ(0u, Stats::percentile(stats.stage(Stats::Solve), 0.5));
+
+    // 1〜100
+    for (std::uint64_t i = 1; i <= 100; ++i) {
+        stats.record(Stats::Solve, i);
+    }
+    const Stats::s_histogram &solve = stats.stage(Stats::Solve);
+    EXPECT_EQ(100u, solve.count);
+    EXPECT_EQ(5050u, solve.sum);
+    EXPECT_EQ(1u, solve.min);
+    EXPECT_EQ(100u, solve.max);
+
+    // 50番目は[32, 64)のbucket -> 上限63. 99番目は[64, 128) -> maxの100に収める
+    EXPECT_EQ(63u, Stats::percentile(solve, 0.5));
+    EXPECT_EQ(100u, Stats::percentile(solve, 0.99));
+    EXPECT_EQ(1u, Stats::percentile(solve, 0.0));
+
+    Stats other;
+    other.record(Stats::Solve, 1000);
+    other.count(s_parse_counts{.tokens = 5, .terms = 2, .insertions = 1});
+    stats.merge(other);
+    EXPECT_EQ(101u, stats.stage(Stats::Solve).count);
+    EXPECT_EQ(1000u, stats.stage(Stats::Solve).max);
+    EXPECT_EQ(5u, stats.counter(Stats::Tokens).sum);
+    EXPECT_EQ(1u, stats.counter(Stats::Insertions).count);
+
+    stats.clear();
+    EXPECT_EQ(0u, stats.stage(Stats::Solve).count);
+    EXPECT_EQ(0u, stats.counter(Stats::Tokens).sum);
+}
+
+TEST(TestStats, TestFormat) {
+    Stats stats;
+    stats.record(Stats::Recognize, 3);
+    OutputBuffer out;
+
+    stats.format(Computor::JSON, &out);
+    EXPECT_EQ(0u, out.view().find("{\"stages\":{\"recognize\":{\"count\":1,\"sum\":3,\"min\":3,"
+                                  "\"max\":3,\"mean\":3,\"p50\":3,\"p90\":3,\"p99\":3,"
+                                  "\"buckets\":[[3,1]]},\"tokenize\":{\"count\":0,"));
+    EXPECT_EQ('\n', out.view().back());
+
+    out.clear();
+    stats.format(Computor::TEXT, &out);
+    std::string text(out.view());
+    EXPECT_EQ(0u, text.find("stage (ns)         count         sum        mean"));
+    EXPECT_NE(std::string::npos, text.find("\nrecognize              1           3           3"));
+    EXPECT_NE(std::string::npos, text.find("\ncounter "));
+    EXPECT_NE(std::string::npos, text.find("\ninsertions "));
+}
+
+TEST(TestStats, TestPipeline) {
+    if (!Stats::kEnabled) {
+        GTEST_SKIP() << "built without COMPUTOR_STATS";
+    }
+    Stats stats;
+    Pipeline pipeline;
+    pipeline.set_stats(&stats);
+    OutputBuffer out;
+
+    // [2][*][X][^][2][+][3][X][=][X][^][2][-][1] : 14 token, 4項, 次数2, 1, 0
+    EXPECT_EQ(EXIT_SUCCESS, pipeline.run("2 * X^2 + 3X = X^2 - 1", &out, &out));
+    EXPECT_EQ(1u, stats.stage(Stats::Recognize).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Reduce).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Solve).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Format).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Total).count);
+    EXPECT_EQ(0u, stats.stage(Stats::Tokenize).count);
+    EXPECT_EQ(0u, stats.stage(Stats::Parse).count);
+    EXPECT_EQ(14u, stats.counter(Stats::Tokens).sum);
+    EXPECT_EQ(4u, stats.counter(Stats::Terms).sum);
+    EXPECT_EQ(3u, stats.counter(Stats::Insertions).sum);
+
+    // recognizeが失敗すると tokenize -> parse でerrorを求める
+    EXPECT_EQ(EXIT_FAILURE, pipeline.run("X^2 + = 1", &out, &out));
+    EXPECT_EQ(2u, stats.stage(Stats::Recognize).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Tokenize).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Parse).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Solve).count);
+    EXPECT_EQ(2u, stats.stage(Stats::Total).count);
+    EXPECT_EQ(2u, stats.counter(Stats::Tokens).count);
+
+    // lexのerrorではparseしない
+    EXPECT_EQ(EXIT_FAILURE, pipeline.run("X + Y = 0", &out, &out));
+    EXPECT_EQ(2u, stats.stage(Stats::Tokenize).count);
+    EXPECT_EQ(1u, stats.stage(Stats::Parse).count);
+    EXPECT_EQ(3u, stats.stage(Stats::Total).count);
+}
+
+// worker毎のStatsをmergeした計数はthread数によらない
+TEST(TestStats, TestBatch) {
+    if (!Stats::kEnabled) {
+        GTEST_SKIP() << "built without COMPUTOR_STATS";
+    }
+    std::string input;
+    for (int i = 0; i < 1000; ++i) {
+        input += (i % 10 == 0) ? "x + y = 0\n" : std::to_string(i) + " * x^2 - x = 1\n";
+    }
+
+    Stats expected;
+    for (std::size_t threads : {1, 4}) {
+        Stats stats;
+        std::istringstream in(input);
+        std::ostringstream out;
+        Computor::s_batch_options options = {.threads = threads, .stats = &stats};
+        EXPECT_EQ(EXIT_SUCCESS, Computor::calc_equation_batch(in, out, options));
+
+        EXPECT_EQ(1000u, stats.stage(Stats::Total).count);
+        EXPECT_EQ(1000u, stats.stage(Stats::Recognize).count);
+        EXPECT_EQ(100u, stats.stage(Stats::Tokenize).count);
+        EXPECT_EQ(900u, stats.stage(Stats::Solve).count);
+        if (threads == 1) {
+            expected.merge(stats);
+            continue;
+        }
+        for (Stats::Counter counter : {Stats::Tokens, Stats::Terms, Stats::Insertions}) {
+            EXPECT_EQ(expected.counter(counter).count, stats.counter(counter).count);
+            EXPECT_EQ(expected.counter(counter).sum, stats.counter(counter).sum);
+            EXPECT_EQ(expected.counter(counter).buckets, stats.counter(counter).buckets);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "gtest/gtest.h"
+
+TEST(TestThreadPool, TestRunAllTasks) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> counts(1000);
+
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        pool.submit([&counts, i](std::size_t) { ++counts[i]; });
+    }
+    pool.wait();
+
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        EXPECT_EQ(1, counts[i].load()) << "task " << i;
+    }
+}
+
+TEST(TestThreadPool, TestWorkerIndex) {
+    ThreadPool pool(3);
+    std::atomic<bool> is_valid(true);
+
+    EXPECT_EQ(3, pool.size());
+    for (int i = 0; i < 300; ++i) {
+        pool.submit([&pool, &is_valid](std::size_t worker) {
+            if (pool.size() <= worker) { is_valid = false; }
+        });
+    }
+    pool.wait();
+    EXPECT_TRUE(is_valid);
+}
+
+// 1つのworkerが止まっていても、そのqueueのtaskは他のworkerがstealして実行する
+TEST(TestThreadPool, TestSteal) {
+    ThreadPool pool(2);
+    std::atomic<bool> is_released(false);
+    std::atomic<int> done(0);
+
+    pool.submit([&is_released](std::size_t) {
+        while (!is_released) { std::this_thread::yield(); }
+    });
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&done](std::size_t) { ++done; });
+    }
+    while (done < 100) { std::this_thread::yield(); }
+    is_released = true;
+    pool.wait();
+    EXPECT_EQ(100, done.load());
+}
+
+TEST(TestThreadPool, TestWaitTwice) {
+    ThreadPool pool(2);
+    std::atomic<int> done(0);
+
+    pool.wait();
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&done](std::size_t) { ++done; });
+    }
+    pool.wait();
+    EXPECT_EQ(10, done.load());
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&done](std::size_t) { ++done; });
+    }
+    pool.wait();
+    EXPECT_EQ(20, done.load());
+}
+
+// 破棄時に残りのtaskを実行してから終了する
+TEST(TestThreadPool, TestDestroy) {
+    std::atomic<int> done(0);
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&done](std::size_t) { ++done; });
+        }
+    }
+    EXPECT_EQ(50, done.load());
+}
@@ -1,4 +1,5 @@
 #include "TestTokenizer.hpp"
+#include <random>
 #include "gtest/gtest.h"
 
 std::string get_kind_str(TokenKind kind) {
@@ -485,3 +486,166 @@ TEST(TestTokenizer, Tagging) {
     expect_eq_tokens(expected_tokens, actual_tokens, __LINE__);
 
 }
+
+
+void expect_eq_token_stream(
+        const std::deque<s_token> &expected,
+        const TokenStream &actual,
+        std::size_t line) {
+    EXPECT_EQ(expected.size(), actual.size()) << " at L:" << line << std::endl;
+    if (expected.size() != actual.size()) {
+        FAIL();
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].word, actual.word(i)) << " at L:" << line << std::endl;
+        EXPECT_EQ(expected[i].kind, actual.kind(i)) << " [" << actual.word(i) <<  "] expected: " << get_kind_str(expected[i].kind) << " but actual: " << get_kind_str(actual.kind(i)) << "  at L:" << line << std::endl;
+    }
+}
+
+TEST(TestTokenizer, LexTokenStream) {
+    Tokenizer tokenizer;
+    std::string equation;
+    std::deque<s_token> expected_tokens;
+    Result<Computor::Status, ErrMsg> result;
+
+    equation = "";
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_err());
+    EXPECT_EQ("invalid equation", result.err_value());
+    EXPECT_TRUE(tokenizer.token_stream().empty());
+
+
+    equation = "     ";
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_TRUE(tokenizer.token_stream().empty());
+
+
+    equation = " 1.5x^2-2*x = 0";
+    expected_tokens = {
+            {.word="1.5", .kind=Decimal},
+            {.word="x", .kind=Char},
+            {.word="^", .kind=TermPowSymbol},
+            {.word="2", .kind=Integer},
+            {.word="-", .kind=OperatorMinus},
+            {.word="2", .kind=Integer},
+            {.word="*", .kind=OperatorMul},
+            {.word="x", .kind=Char},
+            {.word="=", .kind=OperatorEqual},
+            {.word="0", .kind=Integer},
+    };
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_ok());
+    expect_eq_token_stream(expected_tokens, tokenizer.token_stream(), __LINE__);
+
+    // wordは入力バッファを参照する
+    const TokenStream &stream = tokenizer.token_stream();
+    for (std::size_t i = 0; i < stream.size(); ++i) {
+        std::string_view word = stream.word(i);
+        EXPECT_LE(equation.data(), word.data());
+        EXPECT_LE(word.data() + word.size(), equation.data() + equation.size());
+    }
+
+    // Integer, Decimalはdecode済み
+    EXPECT_DOUBLE_EQ(1.5, stream.value(0));
+    EXPECT_DOUBLE_EQ(2.0, stream.value(3));
+    EXPECT_DOUBLE_EQ(2.0, stream.value(5));
+    EXPECT_DOUBLE_EQ(0.0, stream.value(9));
+
+
+    equation = "1" + std::string(400, '0') + " = 0";
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_EQ(Integer, tokenizer.token_stream().kind(0));
+    EXPECT_TRUE(Computor::isnan(tokenizer.token_stream().value(0)));
+
+
+    equation = "1.02xyz + X = 0";
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_err());
+    EXPECT_EQ("syntax error: unexpected token near: xyz", result.err_value());
+
+
+    equation = "X^2 + Y = 0";
+    result = tokenizer.lex(equation);
+    EXPECT_TRUE(result.is_err());
+    EXPECT_EQ("syntax error: unexpected token near: Y", result.err_value());
+}
+
+TEST(TestTokenizer, LexSameAsSplit) {
+    Tokenizer tokenizer;
+    Tokenizer lexer;
+    std::deque<std::string> equations = {
+            "1",
+            "+-=*^",
+            " 1 + 2 = 3 ",
+            "  X ^ 0+X^  1 +X^+2    = 0  =0=++X^123  ",
+            "  1.50X^0 -2.3456X^1 +X^2.0    = 0.0   ",
+            "= -X^0^1 == 0^+1*",
+            "1.02y 1x x123 12.3.X123 12.3X123 x",
+            "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+            "2x3 + 1.x + .5x + 1..2 + 00.00X = 0",
+            "X^0 + Y^0",
+            "x#1 + 1#x = \t",
+    };
+
+    for (const auto &equation : equations) {
+        Result<Tokens, ErrMsg> tokenize_result = tokenizer.tokenize(equation);
+        Result<Computor::Status, ErrMsg> lex_result = lexer.lex(equation);
+
+        std::deque<s_token> expected_tokens = TestTokenizer::tokenize_by_split(equation);
+        expect_eq_tokens(expected_tokens, tokenizer.tokens(), __LINE__);
+        expect_eq_token_stream(expected_tokens, lexer.token_stream(), __LINE__);
+
+        EXPECT_EQ(tokenize_result.is_ok(), lex_result.is_ok()) << equation;
+        if (tokenize_result.is_err() && lex_result.is_err()) {
+            EXPECT_EQ(tokenize_result.err_value(), lex_result.err_value()) << equation;
+        }
+    }
+}
+
+TEST(TestTokenizer, LexSameAsLexByChar) {
+    CharClass::Kernel kernels[] = {CharClass::Scalar, CharClass::SSE2, CharClass::AVX2};
+    CharClass::Kernel detected = CharClass::kernel();
+    Tokenizer tokenizer;
+    Tokenizer by_char;
+    std::mt19937 engine(42);
+    std::string charset = "0123456789.+-*=^   xXy#";
+    std::deque<std::string> equations = {
+            "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+            std::string(63, ' ') + "12.5X",
+            std::string(62, ' ') + "12.5X^2=0",
+            std::string(64, ' ') + "1",
+            std::string(200, '1') + "X = " + std::string(100, '9') + ".5",
+            std::string(70, '1') + "." + std::string(70, '2') + "x",
+    };
+    for (int i = 0; i < 200; ++i) {
+        std::string equation;
+        std::size_t len = engine() % 300;
+        for (std::size_t j = 0; j < len; ++j) {
+            equation += charset[engine() % charset.size()];
+        }
+        equations.push_back(equation);
+    }
+
+    for (auto kernel : kernels) {
+        if (!CharClass::set_kernel(kernel)) { continue; }
+        for (const auto &equation : equations) {
+            Result<Computor::Status, ErrMsg> expected = by_char.lex_by_char(equation);
+            Result<Computor::Status, ErrMsg> actual = tokenizer.lex(equation);
+
+            const TokenStream &expected_stream = by_char.token_stream();
+            const TokenStream &actual_stream = tokenizer.token_stream();
+            ASSERT_EQ(expected_stream.size(), actual_stream.size()) << equation;
+            for (std::size_t idx = 0; idx < expected_stream.size(); ++idx) {
+                EXPECT_EQ(expected_stream.word(idx), actual_stream.word(idx)) << equation;
+                EXPECT_EQ(expected_stream.kind(idx), actual_stream.kind(idx)) << equation;
+            }
+            EXPECT_EQ(expected.is_ok(), actual.is_ok()) << equation;
+            if (expected.is_err() && actual.is_err()) {
+                EXPECT_EQ(expected.err_value(), actual.err_value()) << equation;
+            }
+        }
+    }
+    CharClass::set_kernel(detected);
+}
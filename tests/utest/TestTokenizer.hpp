@@ -1,32 +1,121 @@
 #pragma once
 
+# include <cctype>
+# include <deque>
+# include <string>
 # include "Tokenizer.hpp"
 # include "gtest/gtest.h"
 
+// lex()導入前の多段splitによるtokenizeを、lex()の比較用referenceとして保持する
 class TestTokenizer : public ::testing::Test {
  public:
     static std::deque<std::string> split_by_delimiter(
             const std::string &src,
             char delimiter,
             bool keep_delimiter = false) noexcept(true) {
-        return Tokenizer::split_by_delimiter(src, delimiter, keep_delimiter);
+        std::deque<std::string> split = {};
+        std::string token = "";
+
+        for (char c : src) {
+            if (c != delimiter) {
+                token += c;
+            } else {
+                if (!token.empty()) {
+                    split.push_back(token);
+                    token.clear();
+                }
+                if (keep_delimiter) {
+                    split.push_back(std::string(1, c));
+                }
+            }
+        }
+
+        if (!token.empty()) {
+            split.push_back(token);
+        }
+        return split;
     }
 
     static std::deque<std::string> split_by_delimiter(
             const std::deque<std::string> &src,
             char delimiter,
             bool keep_delimiter = false) noexcept(true) {
-        return Tokenizer::split_by_delimiter(src, delimiter, keep_delimiter);
+        std::deque<std::string> split, split_elem;
+
+        for (const auto &itr : src) {
+            split_elem = TestTokenizer::split_by_delimiter(itr, delimiter, keep_delimiter);
+            split.insert(split.end(), split_elem.begin(), split_elem.end());
+        }
+        return split;
     }
 
     static std::deque<std::string> split_equation(
             const std::string &equation) noexcept(true) {
-        return Tokenizer::split_equation(equation);
+        std::deque<std::string> split;
+
+        // equation
+        split = TestTokenizer::split_by_delimiter(equation, Computor::SP);
+
+        // expression
+        bool keep_delimiter = true;
+        split = TestTokenizer::split_by_delimiter(split, Computor::OP_EQUAL, keep_delimiter);
+
+        // term
+        split = TestTokenizer::split_by_delimiter(split, Computor::OP_MUL, keep_delimiter);
+        split = TestTokenizer::split_by_delimiter(split, Computor::OP_PLUS, keep_delimiter);
+        split = TestTokenizer::split_by_delimiter(split, Computor::OP_MINUS, keep_delimiter);
+        split = TestTokenizer::split_by_delimiter(split, Computor::OP_POW, keep_delimiter);
+        return split;
     }
 
+    // kind none -> split [digit][alpha], like 2X -> [2][X]
+    // num, alphaともにtaggingで再評価されるため、分離できていればOK
     static std::deque<s_token> split_coef_and_base(
             const std::deque<s_token> &tokens) noexcept(true) {
-        return Tokenizer::split_coef_and_base(tokens);
+        std::deque<s_token> split, new_tokens;
+
+        for (auto &token : tokens) {
+            new_tokens = {};
+
+            unsigned char head = static_cast<unsigned char>(token.word[0]);
+            if (token.kind == None && std::isdigit(head)) {
+                std::size_t pos = 0;
+                while (token.word[pos]
+                       && !std::isalpha(static_cast<unsigned char>(token.word[pos]))) {
+                    ++pos;
+                }
+                std::string num = token.word.substr(0, pos);
+                if (TestTokenizer::is_integer(num) || TestTokenizer::is_decimal(num)) {
+                    s_token coef_token = {}; coef_token.word = num;
+                    s_token base_token = {}; base_token.word = token.word.substr(pos);
+                    new_tokens.push_back(coef_token);
+                    new_tokens.push_back(base_token);
+                }
+            }
+
+            if (new_tokens.empty()) {
+                new_tokens.push_back(token);
+            }
+            split.insert(split.end(), new_tokens.begin(), new_tokens.end());
+        }
+        return split;
+    }
+
+    static std::deque<s_token> tokenize_by_split(
+            const std::string &equation) noexcept(true) {
+        std::deque<std::string> split = TestTokenizer::split_equation(equation);
+        std::deque<s_token> tokens = {};
+        for (const auto &word : split) {
+            s_token token = {};
+            token.word = word;
+            token.kind = None;
+            tokens.push_back(token);
+        }
+        TestTokenizer::tagging_operators(&tokens);
+        TestTokenizer::tagging_terms(&tokens);
+        tokens = TestTokenizer::split_coef_and_base(tokens);
+        TestTokenizer::tagging_terms(&tokens);
+        return tokens;
     }
 
     static bool is_char(const std::string &str) noexcept(true) {
@@ -41,4 +130,35 @@ class TestTokenizer : public ::testing::Test {
         return Tokenizer::is_decimal(str);
     }
 
+ private:
+    // +, -, =, *, ^
+    static void tagging_operators(std::deque<s_token> *tokens) noexcept(true) {
+        for (auto &token : *tokens) {
+            if (token.word.length() != 1) { continue; }
+            switch (token.word[0]) {
+                case Computor::OP_PLUS: token.kind = OperatorPlus; break;
+                case Computor::OP_MINUS: token.kind = OperatorMinus; break;
+                case Computor::OP_MUL: token.kind = OperatorMul; break;
+                case Computor::OP_EQUAL: token.kind = OperatorEqual; break;
+                case Computor::OP_POW: token.kind = TermPowSymbol; break;
+                default: break;
+            }
+        }
+    }
+
+    // aX^b
+    // ^^ ^ tagging
+    static void tagging_terms(std::deque<s_token> *tokens) noexcept(true) {
+        for (auto &token : *tokens) {
+            if (token.kind != None) { continue; }
+
+            if (TestTokenizer::is_char(token.word)) {
+                token.kind = Char;
+            } else if (TestTokenizer::is_integer(token.word)) {
+                token.kind = Integer;
+            } else if (TestTokenizer::is_decimal(token.word)) {
+                token.kind = Decimal;
+            }
+        }
+    }
 };
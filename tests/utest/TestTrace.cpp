@@ -0,0 +1,98 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Trace.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::size_t count_lines(const std::string &text, const std::string &word) {
+    std::size_t count = 0;
+    std::size_t pos = text.find(word);
+    while (pos != std::string::npos) {
+        ++count;
+        pos = text.find(word, pos + 1);
+    }
+    return count;
+}
+
+// 他のtestが記録したeventを捨てる
+void drain() {
+    std::ostringstream out;
+    Trace::flush(out);
+}
+
+}  // namespace
+
+TEST(TestTrace, TestFlush) {
+    drain();
+    Trace::record("TestFlush point");
+    Trace::record("TestFlush value", 2.5);
+
+    std::ostringstream out;
+    Trace::flush(out);
+    std::string text = out.str();
+    EXPECT_NE(std::string::npos, text.find("] TestFlush point\n"));
+    EXPECT_NE(std::string::npos, text.find("] TestFlush value 2.5\n"));
+    EXPECT_LT(text.find("TestFlush point"), text.find("TestFlush value"));
+
+    // flush済みのeventは再度書かない
+    std::ostringstream again;
+    Trace::flush(again);
+    EXPECT_EQ(std::string::npos, again.str().find("TestFlush"));
+}
+
+// 満杯のBufferは古いeventから上書きし、失った数をflushで書く
+TEST(TestTrace, TestOverwrite) {
+    drain();
+    for (std::size_t i = 0; i < Trace::kBufferEvents + 10; ++i) {
+        Trace::record("TestOverwrite", static_cast<double>(i));
+    }
+
+    std::ostringstream out;
+    Trace::flush(out);
+    std::string text = out.str();
+    EXPECT_EQ(Trace::kBufferEvents, count_lines(text, "] TestOverwrite "));
+    EXPECT_EQ(std::string::npos, text.find("] TestOverwrite 9\n"));
+    EXPECT_NE(std::string::npos, text.find("] TestOverwrite 10\n"));
+    EXPECT_NE(std::string::npos, text.find("[trace] dropped 10 events\n"));
+}
+
+// thread毎のBufferは終了後も残り、flushで全threadのeventを書く
+TEST(TestTrace, TestThreads) {
+    drain();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([] {
+            for (int j = 0; j < 100; ++j) {
+                Trace::record("TestThreads");
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    std::ostringstream out;
+    Trace::flush(out);
+    EXPECT_EQ(400u, count_lines(out.str(), "] TestThreads\n"));
+}
+
+// COMPUTOR_TRACEを定義しない場合、trace pointは引数を評価しない
+TEST(TestTrace, TestTracePoint) {
+    drain();
+    int evaluated = 0;
+    COMPUTOR_TRACE_POINT("TestTracePoint");
+    COMPUTOR_TRACE_VALUE("TestTracePoint value", ++evaluated);
+
+    std::ostringstream out;
+    Trace::flush(out);
+#ifdef COMPUTOR_TRACE
+    EXPECT_EQ(1, evaluated);
+    EXPECT_EQ(2u, count_lines(out.str(), "] TestTracePoint"));
+#else
+    EXPECT_EQ(0, evaluated);
+    EXPECT_EQ(std::string::npos, out.str().find("TestTracePoint"));
+#endif
+}